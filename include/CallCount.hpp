@@ -7,6 +7,8 @@
 
 namespace IMock {
 
+class InSequence;
+
 /// Is used to access the number of times a mock case has been called or to
 /// verify that a mock case has been called a certain number of times.
 class CallCount {
@@ -14,6 +16,9 @@ class CallCount {
         /// A pointer to a MutableCallCount containing the call count.
         std::shared_ptr<Internal::MutableCallCount> _callCount;
 
+        /// InSequence adds the underlying mock case to its sequence.
+        friend class InSequence;
+
     public:
         /// Creates a CallCount.
         ///
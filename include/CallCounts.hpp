@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include <internal/MutableCallCount.hpp>
+#include <internal/SegmentedVector.hpp>
+#include <CallCount.hpp>
+
+namespace IMock {
+
+/// Gives access to the call counts of a number of mock cases added together,
+/// such as the mock cases added from a table.
+///
+/// A CallCount is only created when a mock case is accessed, which keeps
+/// adding a large number of mock cases cheap.
+class CallCounts {
+    private:
+        /// The storage containing the call counts, which is shared with the
+        /// MockMethod the mock cases were added to.
+        std::shared_ptr<Internal::SegmentedVector<Internal::MutableCallCount>>
+            _callCounts;
+
+        /// The index of the call count of the first mock case in
+        /// _callCounts.
+        std::size_t _first;
+
+        /// The number of mock cases.
+        std::size_t _size;
+
+    public:
+        /// Creates a CallCounts.
+        ///
+        /// @param callCounts The storage containing the call counts.
+        /// @param first The index of the call count of the first mock case.
+        /// @param size The number of mock cases.
+        CallCounts(
+            std::shared_ptr<
+                Internal::SegmentedVector<Internal::MutableCallCount>>
+                callCounts,
+            std::size_t first,
+            std::size_t size)
+            : _callCounts(std::move(callCounts))
+            , _first(first)
+            , _size(size) {
+        }
+
+        /// Gets the number of mock cases.
+        ///
+        /// @return The number of mock cases.
+        std::size_t size() const {
+            // Return the number of mock cases.
+            return _size;
+        }
+
+        /// Gets a CallCount for one of the mock cases.
+        ///
+        /// @param index The index of the mock case in the order they were
+        /// added, which must be less than size().
+        /// @return A CallCount for the mock case.
+        CallCount operator [] (std::size_t index) const {
+            // Create a CallCount sharing the ownership of _callCounts.
+            return CallCount(std::shared_ptr<Internal::MutableCallCount>(
+                _callCounts,
+                &(*_callCounts)[_first + index]));
+        }
+};
+
+}
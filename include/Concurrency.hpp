@@ -0,0 +1,17 @@
+#pragma once
+
+namespace IMock {
+
+/// Decides whether a Mock can be used by several threads at once.
+enum class Concurrency {
+    /// The Mock is only used by one thread at a time.
+    SingleThreaded,
+
+    /// Any number of threads may call the mocked methods at once while mock
+    /// cases are being added. Calls never wait for locks and call counts stay
+    /// exact, while adding mock cases is serialized. Every method must have a
+    /// mock case before Mock::get is called.
+    Concurrent
+};
+
+}
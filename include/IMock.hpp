@@ -1,4 +1,8 @@
 #pragma once
 
+#include <internal/makeUnique.hpp>
+#include <InSequence.hpp>
+#include <Matcher.hpp>
 #include <Mock.hpp>
+#include <MockPool.hpp>
 #include <when.hpp>
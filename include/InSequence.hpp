@@ -0,0 +1,76 @@
+#pragma once
+
+#include <memory>
+
+#include <exception/IncompleteSequenceException.hpp>
+#include <exception/MockCaseInSequenceTwiceException.hpp>
+#include <internal/Sequence.hpp>
+#include <CallCount.hpp>
+
+namespace IMock {
+
+/// Verifies that mock cases, which may belong to different mocks, are called
+/// in a certain order.
+///
+/// Every mock case added to an InSequence is a step. A step may be called any
+/// number of times, but not before the previous step has been called or after
+/// the next step has been called. Calls out of order throw a
+/// WrongCallOrderException immediately, since every call is checked as it is
+/// made.
+class InSequence {
+    private:
+        /// The Sequence keeping track of the progress, which is shared with
+        /// the mock cases in it.
+        std::shared_ptr<Internal::Sequence> _sequence;
+
+    public:
+        /// Creates an InSequence without any steps.
+        InSequence()
+            : _sequence(std::make_shared<Internal::Sequence>()) {
+        }
+
+        /// Adds a mock case as the next step.
+        ///
+        /// Steps must be added before the mock cases in them are called.
+        ///
+        /// @param callCount The CallCount of the mock case to add.
+        /// @return A reference to the InSequence to make it possible to add
+        /// several steps in one statement.
+        /// @throws Throws a MockCaseInSequenceTwiceException if the mock case
+        /// already is a step in a sequence.
+        InSequence& add(const CallCount& callCount) {
+            // Check if the mock case already is a step in a sequence.
+            if(callCount._callCount->hasSequence()) {
+                // Throw a MockCaseInSequenceTwiceException if that's the
+                // case.
+                throw Exception::MockCaseInSequenceTwiceException();
+            }
+
+            // Add a step and make the mock case the step.
+            callCount._callCount->setSequence(
+                _sequence,
+                _sequence->addStep());
+
+            // Return a reference to the InSequence.
+            return *this;
+        }
+
+        /// Verify every step has been called.
+        ///
+        /// @throws Throws an IncompleteSequenceException if a step has not
+        /// been called.
+        void verify() const {
+            // Get the most recently called step.
+            std::size_t calledStep = _sequence->getCalledStep();
+
+            // Check if the last step has been called.
+            if(calledStep != _sequence->getStepCount()) {
+                // Throw an IncompleteSequenceException if that's not the case.
+                throw Exception::IncompleteSequenceException(
+                    _sequence->getStepCount(),
+                    calledStep);
+            }
+        }
+};
+
+}
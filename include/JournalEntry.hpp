@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace IMock {
+
+/// Describes a call recorded in the journal of a Mock.
+struct JournalEntry {
+    /// The number of calls made to the Mock before this call since the
+    /// journal was enabled, which orders the calls across methods.
+    std::uint64_t sequenceNumber;
+
+    /// A string describing how the call was made.
+    std::string callString;
+};
+
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace IMock {
+
+/// Decides if an argument of a call matches a mock case. Matchers can be
+/// passed to with() in place of values to match every value, values fulfilling
+/// a predicate or values comparing to a value in a certain way.
+///
+/// @tparam TValue The type of the argument without references and const.
+template <typename TValue>
+class Matcher {
+    private:
+        /// The predicate deciding if a value matches.
+        std::function<bool (const TValue&)> _predicate;
+
+    public:
+        /// Creates a Matcher using the provided predicate.
+        ///
+        /// @param predicate A callable returning true if the value passed to
+        /// it matches.
+        explicit Matcher(std::function<bool (const TValue&)> predicate)
+            : _predicate(std::move(predicate)) {
+        }
+
+        /// Checks if the provided value matches.
+        ///
+        /// @param value The value to check.
+        /// @return True if the value matches and false otherwise.
+        bool matches(const TValue& value) const {
+            // Let the predicate decide.
+            return _predicate(value);
+        }
+};
+
+/// Checks if a type is a Matcher.
+///
+/// @tparam TValue The type to check.
+template <typename TValue>
+struct IsMatcher : std::false_type {
+};
+
+//! @cond Doxygen_Suppress
+template <typename TValue>
+struct IsMatcher<Matcher<TValue>> : std::true_type {
+};
+//! @endcond
+
+/// Creates a Matcher matching every value.
+///
+/// @return The created Matcher.
+/// @tparam TValue The type of the argument without references and const.
+template <typename TValue>
+Matcher<TValue> any() {
+    // Create a Matcher always returning true.
+    return Matcher<TValue>([](const TValue&) {
+        return true;
+    });
+}
+
+/// Creates a Matcher matching values fulfilling a predicate.
+///
+/// @param predicate A callable taking a value and returning true if it
+/// matches.
+/// @return The created Matcher.
+/// @tparam TValue The type of the argument without references and const.
+/// @tparam TPredicate The type of the predicate.
+template <typename TValue, typename TPredicate>
+Matcher<TValue> matching(TPredicate predicate) {
+    // Create a Matcher calling the predicate.
+    return Matcher<TValue>(std::move(predicate));
+}
+
+/// Creates a Matcher matching values equal to the provided value.
+///
+/// @param expected The value to compare with, which is shared by copies of
+/// the Matcher and therefore does not need a copy constructor.
+/// @return The created Matcher.
+/// @tparam TValue The type of the argument without references and const.
+template <typename TValue>
+Matcher<TValue> equalTo(TValue expected) {
+    // Store the value where copies of the predicate can share it.
+    std::shared_ptr<const TValue> sharedExpected
+        = std::make_shared<const TValue>(std::move(expected));
+
+    // Create a Matcher comparing with the value.
+    return Matcher<TValue>([sharedExpected](const TValue& value) {
+        return value == *sharedExpected;
+    });
+}
+
+/// Creates a Matcher matching values not equal to the provided value.
+///
+/// @param expected The value to compare with.
+/// @return The created Matcher.
+/// @tparam TValue The type of the argument without references and const.
+template <typename TValue>
+Matcher<TValue> notEqualTo(TValue expected) {
+    // Store the value where copies of the predicate can share it.
+    std::shared_ptr<const TValue> sharedExpected
+        = std::make_shared<const TValue>(std::move(expected));
+
+    // Create a Matcher comparing with the value.
+    return Matcher<TValue>([sharedExpected](const TValue& value) {
+        return !(value == *sharedExpected);
+    });
+}
+
+/// Creates a Matcher matching values less than the provided value.
+///
+/// @param bound The value to compare with.
+/// @return The created Matcher.
+/// @tparam TValue The type of the argument without references and const.
+template <typename TValue>
+Matcher<TValue> lessThan(TValue bound) {
+    // Create a Matcher comparing with the value.
+    return Matcher<TValue>([bound](const TValue& value) {
+        return value < bound;
+    });
+}
+
+/// Creates a Matcher matching values less than or equal to the provided
+/// value.
+///
+/// @param bound The value to compare with.
+/// @return The created Matcher.
+/// @tparam TValue The type of the argument without references and const.
+template <typename TValue>
+Matcher<TValue> lessThanOrEqualTo(TValue bound) {
+    // Create a Matcher comparing with the value.
+    return Matcher<TValue>([bound](const TValue& value) {
+        return !(bound < value);
+    });
+}
+
+/// Creates a Matcher matching values greater than the provided value.
+///
+/// @param bound The value to compare with.
+/// @return The created Matcher.
+/// @tparam TValue The type of the argument without references and const.
+template <typename TValue>
+Matcher<TValue> greaterThan(TValue bound) {
+    // Create a Matcher comparing with the value.
+    return Matcher<TValue>([bound](const TValue& value) {
+        return bound < value;
+    });
+}
+
+/// Creates a Matcher matching values greater than or equal to the provided
+/// value.
+///
+/// @param bound The value to compare with.
+/// @return The created Matcher.
+/// @tparam TValue The type of the argument without references and const.
+template <typename TValue>
+Matcher<TValue> greaterThanOrEqualTo(TValue bound) {
+    // Create a Matcher comparing with the value.
+    return Matcher<TValue>([bound](const TValue& value) {
+        return !(value < bound);
+    });
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+namespace IMock {
+
+/// Interface for a source of memory that a Mock can use for its internal
+/// storage instead of the global operator new.
+///
+/// A Mock only asks for memory in large blocks, which it splits up itself, and
+/// gives every block back when it is destroyed.
+class MemoryResource {
+    public:
+        /// Virtual destructor of MemoryResource.
+        virtual ~MemoryResource() noexcept {
+        }
+
+        /// Allocates memory.
+        ///
+        /// @param size The number of bytes to allocate.
+        /// @param alignment The alignment of the memory, which is at most
+        /// alignof(std::max_align_t).
+        /// @return A pointer to the allocated memory.
+        /// @throws Throws an exception if the memory cannot be allocated.
+        virtual void* allocate(std::size_t size, std::size_t alignment) = 0;
+
+        /// Deallocates memory allocated by allocate.
+        ///
+        /// @param memory A pointer to the memory to deallocate.
+        /// @param size The number of bytes given to allocate.
+        /// @param alignment The alignment given to allocate.
+        virtual void deallocate(
+            void* memory,
+            std::size_t size,
+            std::size_t alignment) noexcept = 0;
+};
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace IMock {
+
+/// Describes how calls to a mocked method have been handled, which is only
+/// collected if IMOCK_STATISTICS is defined.
+///
+/// Every call is either a hit or a miss, and every miss is either matched or
+/// unmatched.
+struct MethodStatistics {
+    /// A string describing how a call is made to the method.
+    std::string methodString;
+
+    /// The number of calls made to the method.
+    std::uint64_t callCount;
+
+    /// The number of calls handled without searching the mock cases, either
+    /// since the most recently added mock case matches every call or since
+    /// the call was handled by the mock case that handled a previous call.
+    std::uint64_t hitCount;
+
+    /// The number of calls for which the mock cases were searched.
+    std::uint64_t missCount;
+
+    /// The number of calls that did not match any mock case.
+    std::uint64_t unmatchedCallCount;
+
+    /// A histogram of the number of mock cases checked before a match was
+    /// made. The value at index i is the number of matched calls that checked
+    /// at least 2 to the power of i and less than 2 to the power of i plus one
+    /// mock cases. A hit checks a single mock case. The histogram ends at the
+    /// last non-zero value.
+    std::vector<std::uint64_t> scannedMockCaseHistogram;
+
+    /// A histogram of the time taken by calls to fakes, including calls that
+    /// threw. The value at index i is the number of calls to fakes that took
+    /// less than 2 to the power of i plus one nanoseconds, and at least 2 to
+    /// the power of i nanoseconds unless i is zero. The last possible index
+    /// also counts every slower call. The histogram ends at the last non-zero
+    /// value.
+    std::vector<std::uint64_t> fakeLatencyHistogram;
+};
+
+}
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <cstddef>
+#include <vector>
+
 #include <internal/InnerMock.hpp>
+#include <internal/StatisticsNamespace.hpp>
+#include <Concurrency.hpp>
+#include <JournalEntry.hpp>
+#include <MemoryResource.hpp>
+#include <MethodStatistics.hpp>
 #include <MockCaseID.hpp>
 #include <MockWithID.hpp>
 
 namespace IMock {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
 
 /// Mocks a provided interface to perform wanted actions and return certain
 /// values when its virtual methods are called.
@@ -17,6 +26,14 @@ namespace IMock {
 /// object with a pointer to a buffer filled with custom methods that can be
 /// mocked or faked.
 ///
+/// A Mock is by default only used by one thread at a time. Pass
+/// Concurrency::Concurrent to the constructor to let any number of threads
+/// call the mocked methods while mock cases are being added.
+///
+/// The mock cases are stored in large blocks of memory, which are released at
+/// once when the Mock is destroyed. The blocks are allocated using operator new
+/// unless a MemoryResource is passed to the constructor.
+///
 /// @tparam TInterface The type of interface to be mocked.
 template <typename TInterface>
 class Mock {
@@ -25,8 +42,34 @@ class Mock {
         Internal::InnerMock<TInterface> _innerMock;
 
     public:
+        /// Creates a Mock.
+        ///
+        /// @param concurrency Whether the Mock may be used by several threads
+        /// at once.
+        Mock(Concurrency concurrency = Concurrency::SingleThreaded)
+            : _innerMock(concurrency) {
+        }
+
+        /// Creates a Mock storing its mock cases in memory from the provided
+        /// MemoryResource.
+        ///
+        /// @param memoryResource The MemoryResource to allocate memory from,
+        /// which must outlive the Mock.
+        /// @param concurrency Whether the Mock may be used by several threads
+        /// at once.
+        Mock(
+            MemoryResource& memoryResource,
+            Concurrency concurrency = Concurrency::SingleThreaded)
+            : _innerMock(concurrency, memoryResource) {
+        }
+
         /// Gets an instance of the interface where the virtual methods have
         /// been mocked.
+        ///
+        /// In concurrent mode, every method must have a mock case before
+        /// this is called, since the first mock case of a method can't be
+        /// added while calls may be made. Methods can be mocked again once
+        /// the Mock has been reset.
         TInterface& get() {
             // Call _innerMock.get to get the instance.
             return _innerMock.get();
@@ -42,6 +85,71 @@ class Mock {
             // Create an return a MockWithID with _innerMock.
             return MockWithID<TInterface, id>(_innerMock);
         }
+
+        /// Removes every mock case, which makes the Mock behave as if it had
+        /// just been created, while keeping the memory used to store the mock
+        /// cases. Adding mock cases again is therefore much cheaper than
+        /// creating a new Mock.
+        ///
+        /// CallCount instances created before stay valid and keep their call
+        /// counts. The journal stays enabled if it has been enabled, while the
+        /// calls recorded in it are removed.
+        ///
+        /// This must not be called while calls are being made.
+        void reset() {
+            // Call _innerMock.reset to remove the mock cases.
+            _innerMock.reset();
+        }
+
+        /// Starts recording the calls made to the mocked methods in a journal,
+        /// which keeps the most recent calls to every method in memory
+        /// allocated up front.
+        ///
+        /// The arguments of the calls are copied when recorded and converted
+        /// to strings when the journal is read. Arguments that can't be copied
+        /// are shown as question marks.
+        ///
+        /// @param capacity The number of calls to keep for every method, which
+        /// must be at least one.
+        /// @param sampleInterval Only one in this many calls is recorded,
+        /// which must be at least one.
+        /// @throws Throws an InvalidJournalSettingsException if the capacity or
+        /// the sample interval is zero.
+        /// @throws Throws a JournalEnabledTwiceException if the journal has
+        /// already been enabled.
+        void enableJournal(
+            std::size_t capacity,
+            std::size_t sampleInterval = 1) {
+            // Call _innerMock.enableJournal to enable the journal.
+            _innerMock.enableJournal(capacity, sampleInterval);
+        }
+
+        /// Gets the calls recorded in the journal.
+        ///
+        /// This must not be called while calls are being made.
+        ///
+        /// @return The recorded calls ordered by their sequence numbers.
+        std::vector<JournalEntry> getJournal() {
+            // Call _innerMock.getJournal to get the journal.
+            return _innerMock.getJournal();
+        }
+
+#if defined(IMOCK_STATISTICS)
+        /// Gets statistics describing how calls to the mocked methods have
+        /// been handled, which is only available if IMOCK_STATISTICS is
+        /// defined before IMock is included.
+        ///
+        /// Every method with at least one added mock case is described,
+        /// including methods whose mock cases have been removed by reset.
+        /// This must not be called while calls are being made.
+        ///
+        /// @return MethodStatistics for every method with mock cases.
+        std::vector<MethodStatistics> getStatistics() {
+            // Call _innerMock.getStatistics to get the statistics.
+            return _innerMock.getStatistics();
+        }
+#endif
 };
 
+IMOCK_STATISTICS_NAMESPACE_END
 }
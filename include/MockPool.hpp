@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <internal/makeUnique.hpp>
+#include <internal/NewDeleteMemoryResource.hpp>
+#include <internal/StatisticsNamespace.hpp>
+#include <Concurrency.hpp>
+#include <MemoryResource.hpp>
+#include <Mock.hpp>
+#include <PooledMock.hpp>
+
+namespace IMock {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
+
+/// Hands out mocks of an interface that have already been created, which
+/// makes getting a Mock without mock cases nearly free in tests creating a
+/// large number of them.
+///
+/// Every Mock is handed out as a PooledMock. Once the PooledMock is destroyed,
+/// the Mock is reset, which removes its mock cases while keeping the memory
+/// used to store them, and kept for the next call to acquire.
+///
+/// A MockPool must only be used by one thread at a time and must outlive the
+/// PooledMock instances it hands out.
+///
+/// @tparam TInterface The type of interface to be mocked.
+template <typename TInterface>
+class MockPool {
+    private:
+        /// The MemoryResource the mocks store their mock cases in.
+        MemoryResource& _memoryResource;
+
+        /// Whether the mocks may be used by several threads at once.
+        Concurrency _concurrency;
+
+        /// The mocks that are not handed out.
+        std::vector<std::unique_ptr<Mock<TInterface>>> _mocks;
+
+        /// The number of mocks that have been created and not destroyed.
+        std::size_t _mockCount;
+
+        /// PooledMock returns its Mock when destroyed.
+        friend class PooledMock<TInterface>;
+
+        /// Resets a Mock and keeps it to be handed out again.
+        ///
+        /// @param mock The Mock to return.
+        void release(std::unique_ptr<Mock<TInterface>> mock) noexcept {
+            try {
+                // Reset the Mock and keep it, which doesn't allocate memory
+                // since room for every Mock has been reserved.
+                mock->reset();
+                _mocks.push_back(std::move(mock));
+            }
+            catch(...) {
+                // Destroy the Mock if it could not be reset.
+                _mockCount--;
+            }
+        }
+
+    public:
+        /// Creates an empty MockPool.
+        ///
+        /// @param concurrency Whether the mocks may be used by several threads
+        /// at once.
+        MockPool(Concurrency concurrency = Concurrency::SingleThreaded)
+            : MockPool(
+                Internal::NewDeleteMemoryResource::getInstance(),
+                concurrency) {
+        }
+
+        /// Creates an empty MockPool whose mocks store their mock cases in
+        /// memory from the provided MemoryResource.
+        ///
+        /// @param memoryResource The MemoryResource to allocate memory from,
+        /// which must outlive the MockPool.
+        /// @param concurrency Whether the mocks may be used by several threads
+        /// at once.
+        MockPool(
+            MemoryResource& memoryResource,
+            Concurrency concurrency = Concurrency::SingleThreaded)
+            : _memoryResource(memoryResource)
+            , _concurrency(concurrency)
+            , _mockCount(0) {
+        }
+
+        /// MockPool cannot be copied.
+        MockPool(const MockPool&) = delete;
+
+        /// MockPool cannot be copied.
+        MockPool& operator = (const MockPool&) = delete;
+
+        /// Hands out a Mock without any mock cases, which is created if every
+        /// Mock already has been handed out.
+        ///
+        /// @return A PooledMock returning the Mock to the MockPool when
+        /// destroyed.
+        PooledMock<TInterface> acquire() {
+            // Create a Mock if there is none to hand out.
+            if(_mocks.empty()) {
+                // Make room for every Mock to be returned, which keeps
+                // returning a Mock from allocating memory.
+                _mocks.reserve(_mockCount + 1);
+
+                // Create the Mock.
+                std::unique_ptr<Mock<TInterface>> mock
+                    = Internal::makeUnique<Mock<TInterface>>(
+                        _memoryResource,
+                        _concurrency);
+                _mockCount++;
+                return PooledMock<TInterface>(*this, std::move(mock));
+            }
+
+            // Otherwise, hand out the most recently returned Mock, which is
+            // the most likely to still be in the cache.
+            std::unique_ptr<Mock<TInterface>> mock = std::move(_mocks.back());
+            _mocks.pop_back();
+            return PooledMock<TInterface>(*this, std::move(mock));
+        }
+
+        /// Gets the number of mocks that are not handed out.
+        ///
+        /// @return The number of mocks ready to be handed out.
+        std::size_t getIdleCount() const {
+            // Return the number of kept mocks.
+            return _mocks.size();
+        }
+};
+
+IMOCK_STATISTICS_NAMESPACE_END
+}
@@ -3,17 +3,17 @@
 #include <tuple>
 #include <utility>
 
-#include <exception/MockWithArgumentsUsedTwiceException.hpp>
-#include <internal/Apply.hpp>
-#include <internal/CaseMatchFactory.hpp>
+#include <internal/Arena.hpp>
+#include <internal/ICase.hpp>
 #include <internal/InnerMock.hpp>
-#include <internal/makeUnique.hpp>
+#include <internal/IReturnValue.hpp>
+#include <internal/MockCaseBuilder.hpp>
 #include <internal/MockWithArgumentsCase.hpp>
-#include <Method.hpp>
-#include <CallCount.hpp>
+#include <internal/StatisticsNamespace.hpp>
 #include <MockCaseID.hpp>
 
 namespace IMock {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
 
 /// A Mock with an associated method and arguments to add a mock case for.
 ///
@@ -23,156 +23,54 @@ namespace IMock {
 /// @tparam TArguments The types of the arguments to the method.
 template <typename TInterface, MockCaseID id, typename TReturn,
     typename ...TArguments>
-class MockWithArguments {
+class MockWithArguments
+    : public Internal::MockCaseBuilder<TInterface, TReturn, TArguments...> {
     private:
-        /// The InnerMock to add a mock case to.
-        Internal::InnerMock<TInterface>& _mock;
-
-        /// The method to add a mock case to.
-        Method<TInterface, TReturn, TArguments...> _method;
-
-        /// A string describing how a call is made to the method being mocked.
-        std::string _methodString;
-
         /// The arguments to match calls with.
         std::tuple<TArguments...> _arguments;
 
-        /// Describes if the instance already has been used.
-        bool _used;
-
     public:
         /// Creates a MockWithArguments.
         ///
         /// @param mock The InnerMock to add a mock case to.
-        /// @param method The method to add a mock case to.
+        /// @param methodSlot The MethodSlot of the method to add a mock case
+        /// to.
         /// @param arguments The arguments to match calls with.
         /// @param methodString A string describing how a call is made to the
         /// method being mocked.
         MockWithArguments(
             Internal::InnerMock<TInterface>& mock,
-            Method<TInterface, TReturn, TArguments...> method,
-            std::string methodString,
+            typename Internal::InnerMock<TInterface>::template MethodSlot<
+                TReturn, TArguments...> methodSlot,
+            const char* methodString,
             std::tuple<TArguments...> arguments)
-            : _mock(mock)
-            , _method(std::move(method))
-            , _methodString(std::move(methodString))
-            , _arguments(std::move(arguments))
-            , _used(false) {
-        }
-
-        // The solution for dealing with void has been taken from:
-        // https://eli.thegreenplace.net/2014/sfinae-and-enable_if/
-
-        /// Adds a mock case making the associated method return the provided
-        /// value when called with the associated arguments.
-        ///
-        /// The method is available unless the return type is void. 
-        ///
-        /// @param returnValue The value to return when a match happens.
-        /// @return A CallCount that can be queried about the number of calls
-        /// done to the added mock case.
-        /// @tparam R The return type of the method as infered from TReturn.
-        /// Do not override it.
-        template<typename R = TReturn>
-        CallCount returns(
-            typename std::enable_if<!std::is_void<R>::value, TReturn>::type
-                returnValue) {
-            // Wrap the return value in a tuple. Otherwise, reference values
-            // would not work properly when capturing them.
-            std::tuple<TReturn> wrappedReturnValue = (returnValue);
-
-            // Create a fake.
-            std::function<Internal::CaseMatch<TReturn>
-                (std::tuple<TArguments...>)> fake
-                = [wrappedReturnValue] (std::tuple<TArguments...> arguments) {
-                    // Return a CaseMatch containing the return value.
-                    return Internal::CaseMatchFactory::match<TReturn>(
-                        std::get<0>(wrappedReturnValue));
-                };
-
-            // Forward the call to fakeGeneral.
-            return fakeGeneral(fake);
+            : Internal::MockCaseBuilder<TInterface, TReturn, TArguments...>(
+                mock,
+                std::move(methodSlot),
+                methodString)
+            , _arguments(std::move(arguments)) {
         }
 
-        /// Adds a mock case making the associated method callable when called
-        /// with the associated arguments.
-        ///
-        /// The method is only available if the return type is void.
-        ///
-        /// @return A CallCount that can be queried about the number of calls
-        /// done to the added mock case.
-        /// @tparam R The return type of the method as infered from TReturn.
-        /// Do not override it.
-        template<typename R = TReturn,
-            typename std::enable_if<std::is_void<R>::value, R>::type* = nullptr>
-        CallCount returns() {
-            // Create a fake.
-            std::function<Internal::CaseMatch<TReturn>
-                (std::tuple<TArguments...>)> fake
-                = [] (std::tuple<TArguments...> arguments) {
-                    // Return a CaseMatch for void.
-                    return Internal::CaseMatchFactory::matchVoid();
-                };
-
-            // Forward the call to fakeGeneral.
-            return fakeGeneral(fake);
-        }
-
-        /// Adds a fake handling the method call when called with the associated
+    protected:
+        /// Creates a MockWithArgumentsCase matching calls with the associated
         /// arguments.
         ///
-        /// @param fake A callback to call when the method is called and a match
-        /// happens.
-        /// @return A CallCount that can be queried about the number of calls
-        /// done to the added mock case.
-        CallCount fake(std::function<TReturn (TArguments...)> fake) {
-            // Call fakeGeneral with a fake.
-            return fakeGeneral([fake](std::tuple<TArguments...> arguments) {
-                // Return a CaseMatch for the fake.
-                return Internal::CaseMatchFactory::matchFake(
-                    fake,
-                    std::move(arguments));
-            });
-        }
-
-    private:
-        /// Adds a mock case making calls to the associated method be forwarded
-        /// to fake when called with the associated arguments.
-        ///
-        /// @param fake A callback to be called when a match happens.
-        /// @return A CallCount that can be queried about the number of calls
-        /// done to the added mock case.
-        CallCount fakeGeneral(
-            std::function<Internal::CaseMatch<TReturn>
-                (std::tuple<TArguments...>)> fake) {
-            // Check if the instance already has been used.
-            if(_used) {
-                // Throw a MockWithArgumentsUsedTwiceException since the
-                // instance cannot be used again as the arguments has been
-                // moved.
-                throw Exception::MockWithArgumentsUsedTwiceException();
-            }
-            else {
-                // Raise the _used flag to mark that the instance has been used.
-                _used = true;
-            }
-
-            // Create a MockWithArgumentsCase.
-            std::unique_ptr<Internal::ICase<TReturn, TArguments...>> mockCase
-                = Internal::makeUnique<
+        /// @param returnValue The return value to use when a match happens.
+        /// @return The created mock case.
+        Internal::ArenaPointer<Internal::ICase<TReturn, TArguments...>>
+            createCase(Internal::ArenaPointer<
+                Internal::IReturnValue<TReturn, TArguments...>> returnValue)
+            override {
+            // Create a MockWithArgumentsCase in the InnerMock's Arena.
+            return this->getMock().template create<
                 Internal::MockWithArgumentsCase<TReturn, TArguments...>>(
 
                 // Move the arguments, which means the instance cannot be used
                 // again.
                 std::move(_arguments),
-                fake);
-
-            // Add the case to InnerMock.
-            return _mock.template addCase<id, TReturn, TArguments...>(
-                _method,
-                std::move(_methodString),
-                std::move(mockCase));
+                std::move(returnValue));
         }
 };
 
+IMOCK_STATISTICS_NAMESPACE_END
 }
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <utility>
+
 #include <internal/InnerMock.hpp>
+#include <internal/StatisticsNamespace.hpp>
 #include <Method.hpp>
 #include <MockCaseID.hpp>
 #include <MockWithMethod.hpp>
 
 namespace IMock {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
 
 /// A Mock with an associated MockCaseID used to add a mock case.
 ///
@@ -17,56 +21,95 @@ class MockWithID {
         /// The InnerMock to add a mock case to.
         Internal::InnerMock<TInterface>& _mock;
 
-    public:
-        /// Creates a MockWithID.
-        ///
-        /// @param mock The InnerMock to add a mock case to.
-        MockWithID(Internal::InnerMock<TInterface>& mock)
-            : _mock(mock) {
-        }
-
         /// Creates a MockWithMethod used to add a mock case to the provided
         /// method.
         ///
-        /// @param method The method to add mock cases for.
+        /// @param mock The InnerMock to add a mock case to.
         /// @param methodString A string describing how a call is made to the
         /// method being mocked.
         /// @return A MockWithMethod associated with the method.
+        /// @tparam TMethod The type of the method.
+        /// @tparam method The method to add mock cases for.
         /// @tparam TReturn The return type of the method.
         /// @tparam TArguments The types of the arguments to the method.
-        template <typename TReturn, typename ...TArguments>
-        MockWithMethod<TInterface, id, TReturn, TArguments...> withMethod(
-            Method<TInterface, TReturn, TArguments...> method,
-            std::string methodString) const {
-            // Create and return a MockWithMethod with the InnerMock,
-            // the method and the call string.
+        template <typename TMethod, TMethod method, typename TReturn,
+            typename ...TArguments>
+        static MockWithMethod<TInterface, id, TReturn, TArguments...>
+            createMockWithMethod(
+                Internal::InnerMock<TInterface>& mock,
+                Method<TInterface, TReturn, TArguments...>,
+                const char* methodString) {
+            // Create and return a MockWithMethod with the InnerMock, the
+            // method's MethodSlot and the call string.
             return MockWithMethod<TInterface, id, TReturn, TArguments...>(
-                _mock,
-                method,
-                std::move(methodString));
+                mock,
+                Internal::InnerMock<TInterface>::template getMethodSlot<
+                    TMethod, method, TReturn, TArguments...>(),
+                methodString);
         }
 
         /// Creates a MockWithMethod used to add a mock case to the provided
         /// constant method.
         ///
-        /// @param method The constant method to add mock cases for.
+        /// @param mock The InnerMock to add a mock case to.
         /// @param methodString A string describing how a call is made to the
         /// constant method being mocked.
         /// @return A MockWithMethod associated with the constant method.
+        /// @tparam TMethod The type of the constant method.
+        /// @tparam method The constant method to add mock cases for.
         /// @tparam TReturn The return type of the constant method.
         /// @tparam TArguments The types of the arguments to the constant
         /// method.
-        template <typename TReturn, typename ...TArguments>
-        MockWithMethod<TInterface, id, TReturn, TArguments...> withMethod(
-            TReturn (TInterface::*method)(TArguments...) const,
-            std::string methodString) const {
-            // Cast the constant method to a regular method and forward the call
-            // to the regular withMethod.
-            return withMethod(
-                reinterpret_cast<Method<TInterface, TReturn, TArguments...>>(
-                    method),
-                std::move(methodString));
+        template <typename TMethod, TMethod method, typename TReturn,
+            typename ...TArguments>
+        static MockWithMethod<TInterface, id, TReturn, TArguments...>
+            createMockWithMethod(
+                Internal::InnerMock<TInterface>& mock,
+                TReturn (TInterface::*)(TArguments...) const,
+                const char* methodString) {
+            // Create and return a MockWithMethod with the InnerMock, the
+            // constant method's MethodSlot and the call string. A constant
+            // method is called like a regular method, which means the same
+            // kind of MethodSlot can be used.
+            return MockWithMethod<TInterface, id, TReturn, TArguments...>(
+                mock,
+                Internal::InnerMock<TInterface>::template getMethodSlot<
+                    TMethod, method, TReturn, TArguments...>(),
+                methodString);
+        }
+
+    public:
+        /// Creates a MockWithID.
+        ///
+        /// @param mock The InnerMock to add a mock case to.
+        MockWithID(Internal::InnerMock<TInterface>& mock)
+            : _mock(mock) {
+        }
+
+        /// Creates a MockWithMethod used to add a mock case to the provided
+        /// method, which may be constant.
+        ///
+        /// @param methodString A string describing how a call is made to the
+        /// method being mocked, which must outlive the MockWithMethod, such as
+        /// a string literal. The string is only copied when the first mock
+        /// case of the method is added.
+        /// @return A MockWithMethod associated with the method.
+        /// @tparam TMethod The type of the method.
+        /// @tparam method The method to add mock cases for.
+        template <typename TMethod, TMethod method>
+        auto withMethod(const char* methodString) const
+            -> decltype(createMockWithMethod<TMethod, method>(
+                std::declval<Internal::InnerMock<TInterface>&>(),
+                method,
+                methodString)) {
+            // Forward the call to the createMockWithMethod matching the
+            // method.
+            return createMockWithMethod<TMethod, method>(
+                _mock,
+                method,
+                methodString);
         }
 };
 
+IMOCK_STATISTICS_NAMESPACE_END
 }
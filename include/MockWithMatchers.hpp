@@ -0,0 +1,81 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <internal/Arena.hpp>
+#include <internal/ICase.hpp>
+#include <internal/InnerMock.hpp>
+#include <internal/IReturnValue.hpp>
+#include <internal/MockCaseBuilder.hpp>
+#include <internal/MockWithMatchersCase.hpp>
+#include <internal/StatisticsNamespace.hpp>
+#include <Matcher.hpp>
+#include <MockCaseID.hpp>
+
+namespace IMock {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
+
+/// A Mock with an associated method and Matcher instances to add a mock case
+/// for.
+///
+/// @tparam TInterface The interface that the mocked method belongs to.
+/// @tparam id The MockWithID used to identify the mock case.
+/// @tparam TReturn The return type of the method.
+/// @tparam TArguments The types of the arguments to the method.
+template <typename TInterface, MockCaseID id, typename TReturn,
+    typename ...TArguments>
+class MockWithMatchers
+    : public Internal::MockCaseBuilder<TInterface, TReturn, TArguments...> {
+    private:
+        /// The matchers to match calls with.
+        std::tuple<Matcher<typename std::decay<TArguments>::type>...>
+            _matchers;
+
+    public:
+        /// Creates a MockWithMatchers.
+        ///
+        /// @param mock The InnerMock to add a mock case to.
+        /// @param methodSlot The MethodSlot of the method to add a mock case
+        /// to.
+        /// @param methodString A string describing how a call is made to the
+        /// method being mocked.
+        /// @param matchers The matchers to match calls with.
+        MockWithMatchers(
+            Internal::InnerMock<TInterface>& mock,
+            typename Internal::InnerMock<TInterface>::template MethodSlot<
+                TReturn, TArguments...> methodSlot,
+            const char* methodString,
+            std::tuple<Matcher<typename std::decay<TArguments>::type>...>
+                matchers)
+            : Internal::MockCaseBuilder<TInterface, TReturn, TArguments...>(
+                mock,
+                std::move(methodSlot),
+                methodString)
+            , _matchers(std::move(matchers)) {
+        }
+
+    protected:
+        /// Creates a MockWithMatchersCase matching calls with the associated
+        /// matchers.
+        ///
+        /// @param returnValue The return value to use when a match happens.
+        /// @return The created mock case.
+        Internal::ArenaPointer<Internal::ICase<TReturn, TArguments...>>
+            createCase(Internal::ArenaPointer<
+                Internal::IReturnValue<TReturn, TArguments...>> returnValue)
+            override {
+            // Create a MockWithMatchersCase in the InnerMock's Arena.
+            return this->getMock().template create<
+                Internal::MockWithMatchersCase<TReturn, TArguments...>>(
+
+                // Move the matchers, which means the instance cannot be used
+                // again.
+                std::move(_matchers),
+                std::move(returnValue));
+        }
+};
+
+IMOCK_STATISTICS_NAMESPACE_END
+}
@@ -1,12 +1,24 @@
 #pragma once
 
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <internal/Arena.hpp>
 #include <internal/InnerMock.hpp>
+#include <internal/IReturnValue.hpp>
 #include <internal/MockWithMethodCase.hpp>
-#include <Method.hpp>
+#include <internal/StatisticsNamespace.hpp>
+#include <internal/ToMatcher.hpp>
+#include <CallCounts.hpp>
 #include <MockCaseID.hpp>
 #include <MockWithArguments.hpp>
+#include <MockWithMatchers.hpp>
 
 namespace IMock {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
 
 /// A Mock with an associated method to add a mock case for.
 ///
@@ -21,26 +33,30 @@ class MockWithMethod {
         /// The InnerMock to add a mock case to.
         Internal::InnerMock<TInterface>& _mock;
 
-        /// The method to add a mock case to.
-        Method<TInterface, TReturn, TArguments...> _method;
+        /// The MethodSlot of the method to add a mock case to.
+        typename Internal::InnerMock<TInterface>::template MethodSlot<
+            TReturn, TArguments...> _methodSlot;
 
-        /// A string describing how a call is made to the method being mocked.
-        std::string _methodString;
+        /// A string describing how a call is made to the method being mocked,
+        /// which is a string literal created by when.
+        const char* _methodString;
 
     public:
         /// Creates a MockWithMethod.
         ///
         /// @param mock The InnerMock to add a mock case to.
-        /// @param method The method to add a mock case to.
+        /// @param methodSlot The MethodSlot of the method to add a mock case
+        /// to.
         /// @param methodString A string describing how a call is made to the
         /// method being mocked.
         MockWithMethod(
             Internal::InnerMock<TInterface>& mock,
-            Method<TInterface, TReturn, TArguments...> method,
-            std::string methodString)
+            typename Internal::InnerMock<TInterface>::template MethodSlot<
+                TReturn, TArguments...> methodSlot,
+            const char* methodString)
             : _mock(mock)
-            , _method(std::move(method))
-            , _methodString(std::move(methodString)) {
+            , _methodSlot(std::move(methodSlot))
+            , _methodString(methodString) {
         }
 
         /// Creates a MockWithArguments used to add a mock case matching the
@@ -54,29 +70,156 @@ class MockWithMethod {
             // the method, the call string and the arguments.
             return MockWithArguments<TInterface, id, TReturn, TArguments...>(
                 _mock,
-                _method,
+                _methodSlot,
                 _methodString,
                 std::tuple<TArguments...>(
                     std::forward<TArguments>(arguments)...));
         }
 
+        /// Creates a MockWithMatchers used to add a mock case matching calls
+        /// whose arguments are matched by the provided Matcher instances.
+        ///
+        /// The method is only available if at least one Matcher is provided.
+        /// Arguments provided as values instead of as Matcher instances are
+        /// copied and compared with ==.
+        ///
+        /// Mock cases added with matchers can't be indexed, which means they
+        /// are scanned on every call while mock cases added with values only
+        /// are found in constant time.
+        ///
+        /// @param matchers A Matcher or a value for every argument.
+        /// @return A MockWithMatchers associated with the matchers.
+        /// @tparam TMatchers The types of the provided matchers and values.
+        template <typename ...TMatchers>
+        typename std::enable_if<
+            sizeof...(TMatchers) == sizeof...(TArguments)
+                && Internal::ContainsMatcher<TMatchers...>::value,
+            MockWithMatchers<TInterface, id, TReturn, TArguments...>>::type
+            with(TMatchers&&... matchers) const {
+            // Create and return a MockWithMatchers with the InnerMock, the
+            // method, the call string and the matchers.
+            return MockWithMatchers<TInterface, id, TReturn, TArguments...>(
+                _mock,
+                _methodSlot,
+                _methodString,
+                std::tuple<Matcher<typename std::decay<TArguments>::type>...>(
+                    Internal::ToMatcher<typename std::decay<TArguments>::type>
+                        ::toMatcher(std::forward<TMatchers>(matchers))...));
+        }
+
         /// Adds a fake handling the method call.
         ///
-        /// @param fake A callback to call when the method is called.
+        /// @param fake A callable to call when the method is called, which is
+        /// stored with its own type.
         /// @return A CallCount that can be queried about the number of calls
         /// done to the added mock case.
-        CallCount fake(std::function<TReturn (TArguments...)> fake) {
-            // Create a MockWithMethodCase.
-            std::unique_ptr<Internal::ICase<TReturn, TArguments...>> mockCase
-                = Internal::makeUnique<Internal::MockWithMethodCase<
-                    TReturn, TArguments...>>(fake);
+        /// @tparam TFake The type of the callable.
+        template <typename TFake>
+        CallCount fake(TFake fake) {
+            // Create a MockWithMethodCase calling the fake in the InnerMock's
+            // Arena, which records the time taken by calls in the statistics
+            // of the method if statistics are enabled.
+            Internal::ArenaPointer<Internal::ICase<TReturn, TArguments...>>
+                mockCase = _mock.template create<
+                    Internal::MockWithMethodCase<TReturn, TArguments...>>(
+                        _mock.template create<Internal::FakeReturnValue<
+                            TFake, TReturn, TArguments...>>(
+                                std::move(fake),
+                                _mock.template getStatisticsRecorder<
+                                    TReturn, TArguments...>(
+                                        _methodSlot,
+                                        _methodString)));
 
             // Add the case to InnerMock.
-            return _mock.template addCase<id, TReturn, TArguments...>(
-                _method,
+            return _mock.template addCase<TReturn, TArguments...>(
+                _methodSlot,
                 _methodString,
                 std::move(mockCase));
         }
+
+        /// Adds a mock case for every entry in a table, making calls with the
+        /// arguments of an entry return its value. Later entries take
+        /// precedence over earlier ones, as if every entry had been added
+        /// with with() and returns() in order.
+        ///
+        /// The entries are added in a single pass, which makes adding a large
+        /// number of them much faster than adding them one by one.
+        ///
+        /// The method is only available if the return type is not void and
+        /// can be copied, since every call matching an entry returns a copy
+        /// of its value.
+        ///
+        /// @param begin An iterator to the first entry.
+        /// @param end An iterator past the last entry.
+        /// @return A CallCounts that can be queried about the number of calls
+        /// done to the added mock cases in the order of the entries.
+        /// @tparam TIterator The type of the iterators, whose entries must
+        /// have a tuple of the arguments as first and the value to return as
+        /// second, such as the entries of a map.
+        /// @tparam R The return type of the method as infered from TReturn.
+        /// Do not override it.
+        template <typename TIterator, typename R = TReturn>
+        typename std::enable_if<
+            !std::is_void<R>::value && std::is_copy_constructible<R>::value,
+            CallCounts>::type
+            table(TIterator begin, TIterator end) {
+            // Add the entries to InnerMock.
+            return _mock.template addTable<TReturn, TArguments...>(
+                _methodSlot,
+                _methodString,
+                std::move(begin),
+                std::move(end));
+        }
+
+        /// Adds a mock case for every entry in a range, making calls with the
+        /// arguments of an entry return its value. Later entries take
+        /// precedence over earlier ones.
+        ///
+        /// The method is only available if the return type is not void and
+        /// can be copied, since every call matching an entry returns a copy
+        /// of its value.
+        ///
+        /// @param range The range containing the entries, such as a vector or
+        /// a map.
+        /// @return A CallCounts that can be queried about the number of calls
+        /// done to the added mock cases in the order of the entries.
+        /// @tparam TRange The type of the range, whose entries must have a
+        /// tuple of the arguments as first and the value to return as second.
+        /// @tparam R The return type of the method as infered from TReturn.
+        /// Do not override it.
+        template <typename TRange, typename R = TReturn>
+        typename std::enable_if<
+            !std::is_void<R>::value && std::is_copy_constructible<R>::value,
+            CallCounts>::type
+            table(const TRange& range) {
+            // Add the entries between the beginning and the end of the range.
+            return table(std::begin(range), std::end(range));
+        }
+
+        /// Adds a mock case for every entry in a list, making calls with the
+        /// arguments of an entry return its value. Later entries take
+        /// precedence over earlier ones.
+        ///
+        /// The method is only available if the return type is not void and
+        /// can be copied, since every call matching an entry returns a copy
+        /// of its value.
+        ///
+        /// @param entries The entries, each consisting of a tuple of the
+        /// arguments and the value to return.
+        /// @return A CallCounts that can be queried about the number of calls
+        /// done to the added mock cases in the order of the entries.
+        /// @tparam R The return type of the method as infered from TReturn.
+        /// Do not override it.
+        template <typename R = TReturn>
+        typename std::enable_if<
+            !std::is_void<R>::value && std::is_copy_constructible<R>::value,
+            CallCounts>::type
+            table(std::initializer_list<
+                std::pair<std::tuple<TArguments...>, R>> entries) {
+            // Add the entries between the beginning and the end of the list.
+            return table(entries.begin(), entries.end());
+        }
 };
 
+IMOCK_STATISTICS_NAMESPACE_END
 }
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include <internal/StatisticsNamespace.hpp>
+#include <Mock.hpp>
+#include <MockCaseID.hpp>
+#include <MockWithID.hpp>
+
+namespace IMock {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
+
+template <typename TInterface>
+class MockPool;
+
+/// A Mock handed out by a MockPool, which is reset and returned to the
+/// MockPool when the PooledMock is destroyed.
+///
+/// A PooledMock is used just like a Mock, which means mock cases are added to
+/// it using when.
+///
+/// @tparam TInterface The type of interface to be mocked.
+template <typename TInterface>
+class PooledMock {
+    private:
+        /// The MockPool to return the Mock to.
+        MockPool<TInterface>* _pool;
+
+        /// The Mock, or nullptr if the PooledMock has been moved.
+        std::unique_ptr<Mock<TInterface>> _mock;
+
+    public:
+        /// Creates a PooledMock.
+        ///
+        /// @param pool The MockPool to return the Mock to.
+        /// @param mock The Mock, which has no mock cases.
+        PooledMock(
+            MockPool<TInterface>& pool,
+            std::unique_ptr<Mock<TInterface>> mock)
+            : _pool(&pool)
+            , _mock(std::move(mock)) {
+        }
+
+        /// Moves a PooledMock, which leaves the moved PooledMock without a
+        /// Mock.
+        ///
+        /// @param other The PooledMock to move.
+        PooledMock(PooledMock&& other) noexcept
+            : _pool(other._pool)
+            , _mock(std::move(other._mock)) {
+        }
+
+        /// PooledMock cannot be copied.
+        PooledMock(const PooledMock&) = delete;
+
+        /// PooledMock cannot be assigned.
+        PooledMock& operator = (const PooledMock&) = delete;
+
+        /// Destructs the PooledMock by returning the Mock to the MockPool.
+        ~PooledMock() noexcept {
+            // Return the Mock unless the PooledMock has been moved.
+            if(_mock != nullptr) {
+                _pool->release(std::move(_mock));
+            }
+        }
+
+        /// Gets the Mock.
+        ///
+        /// @return A reference to the Mock.
+        Mock<TInterface>& getMock() {
+            // Return the Mock.
+            return *_mock;
+        }
+
+        /// Gets an instance of the interface where the virtual methods have
+        /// been mocked.
+        TInterface& get() {
+            // Call _mock->get to get the instance.
+            return _mock->get();
+        }
+
+        /// Creates a MockWithID used to add a mock case.
+        /// The MockCaseID must differ from other mock cases used with the same
+        /// Mock.
+        /// @return A MockWithID associated with the MockCaseID.
+        /// @tparam id The MockWithID used to identify the mock case to add.
+        template <MockCaseID id>
+        MockWithID<TInterface, id> withCounter() {
+            // Call _mock->withCounter to create the MockWithID.
+            return _mock->template withCounter<id>();
+        }
+};
+
+IMOCK_STATISTICS_NAMESPACE_END
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <sstream>
+
+#include <exception/MockException.hpp>
+
+namespace IMock {
+namespace Exception {
+
+/// Thrown when an InSequence is verified before every step has been called.
+class IncompleteSequenceException : public MockException {
+    public:
+        /// Creates an IncompleteSequenceException.
+        ///
+        /// @param stepCount The number of steps in the sequence.
+        /// @param calledStep The most recently called step, or zero if no
+        /// step has been called.
+        IncompleteSequenceException(
+            std::size_t stepCount,
+            std::size_t calledStep)
+            : MockException(getMessage(stepCount, calledStep)) {
+        }
+
+    private:
+        /// Creates an exception message.
+        ///
+        /// @param stepCount The number of steps in the sequence.
+        /// @param calledStep The most recently called step, or zero if no
+        /// step has been called.
+        /// @return A generated exception message.
+        static std::string getMessage(
+            std::size_t stepCount,
+            std::size_t calledStep) {
+            // Create a stringstream.
+            std::stringstream out;
+
+            // Append the number of called steps and the number of steps.
+            out << "Expected all "
+                << stepCount
+                << " steps of the sequence to be called but only "
+                << calledStep
+                << " of them ";
+
+            // Check if the number of called steps should be referred to in
+            // singular.
+            if(calledStep == 1) {
+                // Append "was" if that's the case.
+                out << "was";
+            }
+            else {
+                // Otherwise, append "were".
+                out << "were";
+            }
+
+            // Append the rest of the sentence.
+            out << " called.";
+
+            // Create a string and return it.
+            return out.str();
+        }
+};
+
+}
+}
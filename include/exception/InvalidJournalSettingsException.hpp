@@ -0,0 +1,20 @@
+#pragma once
+
+#include <exception/MockException.hpp>
+
+namespace IMock {
+namespace Exception {
+
+/// Thrown when the journal of a Mock is enabled with a capacity or a sample
+/// interval of zero.
+class InvalidJournalSettingsException : public MockException {
+    public:
+        /// Creates an InvalidJournalSettingsException.
+        InvalidJournalSettingsException()
+            : MockException("The journal of a Mock was enabled with a capacity"
+                " or a sample interval of zero. Both must be at least one.") {
+        }
+};
+
+}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <exception/MockException.hpp>
+
+namespace IMock {
+namespace Exception {
+
+/// Thrown when the journal of a Mock is enabled more than once.
+class JournalEnabledTwiceException : public MockException {
+    public:
+        /// Creates a JournalEnabledTwiceException.
+        JournalEnabledTwiceException()
+            : MockException("The journal of a Mock was enabled twice."
+                " It can only be enabled once.") {
+        }
+};
+
+}
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+#include <exception/MockException.hpp>
+
+namespace IMock {
+namespace Exception {
+
+/// Thrown when the first mock case of a method is added to a concurrent Mock
+/// after the Mock has been handed out to make calls, since inserting the method
+/// into the virtual table while other threads may call through it is a data
+/// race.
+class MethodMockedAfterCallsException : public MockException {
+    public:
+        /// Creates a MethodMockedAfterCallsException.
+        ///
+        /// @param methodString A string describing how a call is made to the
+        /// method being mocked.
+        MethodMockedAfterCallsException(const std::string& methodString)
+            : MockException("The first mock case of " + methodString
+                + " was added to a concurrent Mock after get() had been called."
+                " Add a mock case to every method before calls are made.") {
+        }
+};
+
+}
+}
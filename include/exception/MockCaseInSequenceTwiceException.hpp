@@ -0,0 +1,20 @@
+#pragma once
+
+#include <exception/MockException.hpp>
+
+namespace IMock {
+namespace Exception {
+
+/// Thrown when a mock case is added to an InSequence when it already belongs
+/// to one.
+class MockCaseInSequenceTwiceException : public MockException {
+    public:
+        /// Creates a MockCaseInSequenceTwiceException.
+        MockCaseInSequenceTwiceException()
+            : MockException("A mock case was added to a sequence twice."
+                " A mock case can only be a single step in one sequence.") {
+        }
+};
+
+}
+}
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <exception>
+#include <memory>
 #include <string>
 
+#include <internal/LazyMessage.hpp>
+
 namespace IMock {
 namespace Exception {
 
@@ -11,7 +14,21 @@ class MockException : public std::exception {
     private:
         /// An explanation of what went wrong.
         std::string message;
+
+        /// An explanation of what went wrong that is created when needed, or
+        /// nullptr if message is used. It is shared between copies of the
+        /// exception to only be created once.
+        std::shared_ptr<Internal::LazyMessage> lazyMessage;
     
+    protected:
+        /// Creates a MockException with a message that is created the first
+        /// time what() is called.
+        ///
+        /// @param lazyMessage An explanation of what went wrong.
+        MockException(std::shared_ptr<Internal::LazyMessage> lazyMessage)
+            : lazyMessage(std::move(lazyMessage)) {
+        }
+
     public:
         /// Creates a MockException.
         ///
@@ -24,7 +41,13 @@ class MockException : public std::exception {
         ///
         /// @return A constant pointer to the message.
         const char* what() const noexcept override {
-            // Return a constant pointer to the message.
+            // Return a constant pointer to the lazily created message if
+            // there is one.
+            if(lazyMessage != nullptr) {
+                return lazyMessage->get().c_str();
+            }
+
+            // Otherwise, return a constant pointer to the message.
             return message.c_str();
         }
 };
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <exception/MockException.hpp>
+
+namespace IMock {
+namespace Exception {
+
+/// Thrown when a method that is not virtual is mocked.
+class NonVirtualMethodException : public MockException {
+    public:
+        /// Creates a NonVirtualMethodException.
+        NonVirtualMethodException()
+            : MockException("A method that is not virtual was mocked."
+                " Only virtual methods can be mocked.") {
+        }
+};
+
+}
+}
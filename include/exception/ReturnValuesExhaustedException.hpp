@@ -0,0 +1,21 @@
+#pragma once
+
+#include <exception/MockException.hpp>
+
+namespace IMock {
+namespace Exception {
+
+/// Thrown when a mock case returning a sequence of values once each is called
+/// after every value has been returned.
+class ReturnValuesExhaustedException : public MockException {
+    public:
+        /// Creates a ReturnValuesExhaustedException.
+        ReturnValuesExhaustedException()
+            : MockException("Every return value of a mock case has already"
+                " been returned. Values without copy constructors and values"
+                " passed to returnsOnce are only returned once.") {
+        }
+};
+
+}
+}
@@ -1,6 +1,13 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
 #include <exception/MockException.hpp>
+#include <internal/CallString.hpp>
+#include <internal/LazyMessage.hpp>
 
 namespace IMock {
 namespace Exception {
@@ -8,6 +15,46 @@ namespace Exception {
 /// Thrown when a call was made to a method that has been mocked but the
 /// arguments does not match any mocked arguments.
 class UnmockedCallException : public MockException {
+    private:
+        /// A message created from the arguments of a call when it is first
+        /// needed.
+        ///
+        /// @tparam TArguments The types of the arguments of the call.
+        template <typename ...TArguments>
+        class CallMessage : public Internal::LazyMessage {
+            private:
+                /// A string describing how a call is made to the method.
+                std::shared_ptr<const std::string> _methodString;
+
+                /// The arguments of the call.
+                std::tuple<TArguments...> _arguments;
+
+            protected:
+                /// Creates the message from the method string and the
+                /// arguments.
+                ///
+                /// @return The message.
+                std::string createMessage() override {
+                    // Create a call string and then a message containing it.
+                    return getMessage(Internal::CallString::create(
+                        *_methodString,
+                        _arguments));
+                }
+
+            public:
+                /// Creates a CallMessage.
+                ///
+                /// @param methodString A string describing how a call is made
+                /// to the method.
+                /// @param arguments The arguments of the call.
+                CallMessage(
+                    std::shared_ptr<const std::string> methodString,
+                    std::tuple<TArguments...> arguments)
+                    : _methodString(std::move(methodString))
+                    , _arguments(std::move(arguments)) {
+                }
+        };
+
     public:
         /// Creates an UnmockedCallException.
         ///
@@ -17,6 +64,23 @@ class UnmockedCallException : public MockException {
             : MockException(getMessage(std::move(callString))) {
         }
 
+        /// Creates an UnmockedCallException that keeps the arguments of the
+        /// call and only creates its message when what() is first called.
+        ///
+        /// @param methodString A string describing how a call is made to the
+        /// method.
+        /// @param arguments The arguments of the call.
+        /// @tparam TArguments The types of the arguments of the call, which
+        /// must not be references.
+        template <typename ...TArguments>
+        UnmockedCallException(
+            std::shared_ptr<const std::string> methodString,
+            std::tuple<TArguments...> arguments)
+            : MockException(std::make_shared<CallMessage<TArguments...>>(
+                std::move(methodString),
+                std::move(arguments))) {
+        }
+
     private:
         /// Creates an exception message.
         ///
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <sstream>
+
+#include <exception/MockException.hpp>
+
+namespace IMock {
+namespace Exception {
+
+/// Thrown when a mock case in an InSequence is called out of order.
+class WrongCallOrderException : public MockException {
+    public:
+        /// Creates a WrongCallOrderException.
+        ///
+        /// @param step The step of the called mock case.
+        /// @param calledStep The most recently called step, or zero if no
+        /// step had been called.
+        WrongCallOrderException(
+            std::size_t step,
+            std::size_t calledStep)
+            : MockException(getMessage(step, calledStep)) {
+        }
+
+    private:
+        /// Creates an exception message.
+        ///
+        /// @param step The step of the called mock case.
+        /// @param calledStep The most recently called step, or zero if no
+        /// step had been called.
+        /// @return A generated exception message.
+        static std::string getMessage(
+            std::size_t step,
+            std::size_t calledStep) {
+            // Create a stringstream.
+            std::stringstream out;
+
+            // Append the called step.
+            out << "Step "
+                << step
+                << " of a sequence was called ";
+
+            // Append the most recently called step, if any.
+            if(calledStep == 0) {
+                out << "before step 1.";
+            }
+            else {
+                out << "after step "
+                    << calledStep
+                    << ".";
+            }
+
+            // Create a string and return it.
+            return out.str();
+        }
+};
+
+}
+}
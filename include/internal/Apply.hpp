@@ -1,7 +1,8 @@
 #pragma once
 
 #include <tuple>
-#include <functional>
+#include <type_traits>
+#include <utility>
 
 namespace IMock {
 namespace Internal {
@@ -28,26 +29,55 @@ class Apply {
         //! @endcond
 
         /// Calls the provided callback with the arguments in the provided
-        /// tuple.
+        /// tuple and returns its return value.
+        ///
+        /// Also includes a "seq" making it possible to extract the arguments
+        /// from the tuple.
+        ///
+        /// @param callback The callable to call.
+        /// @param arguments The arguments to call the callback with.
+        /// @return The return value from the callback implicitly converted to
+        /// TReturn.
+        /// @tparam TReturn The return type.
+        /// @tparam TArguments The types of the arguments.
+        /// @tparam A counter used to extract arguments.
+        /// @tparam TCallback The type of the callback.
+        /// @tparam TTuple The type of the tuple.
+        template<typename TReturn, typename ...TArguments, int ...S,
+            typename TCallback, typename TTuple>
+        static TReturn applyWithSeq(
+            seq<S...>,
+            std::false_type,
+            TCallback& callback,
+            TTuple& arguments) {
+            // Call callback with the extracted arguments and return its
+            // return value, which only allows implicit conversions.
+            return callback(
+                std::forward<TArguments>(std::get<S>(arguments))...);
+        }
+
+        /// Calls the provided callback with the arguments in the provided
+        /// tuple and discards its return value, if any, since TReturn is void.
         ///
         /// Also includes a "seq" making it possible to extract the arguments
         /// from the tuple.
         ///
-        /// @param callback The function to call.
+        /// @param callback The callable to call.
         /// @param arguments The arguments to call the callback with.
-        /// @return The return value from the callback.
+        /// @tparam TReturn The return type, which is void.
+        /// @tparam TArguments The types of the arguments.
         /// @tparam A counter used to extract arguments.
-        /// @tparam TReturn The return type of the callback.
-        /// @tparam TArguments The types of the arguments of the callback.
-        template<int ...S, typename TReturn,
-            typename ...TArguments>
+        /// @tparam TCallback The type of the callback.
+        /// @tparam TTuple The type of the tuple.
+        template<typename TReturn, typename ...TArguments, int ...S,
+            typename TCallback, typename TTuple>
         static TReturn applyWithSeq(
             seq<S...>,
-            std::function<TReturn (TArguments...)> callback,
-            std::tuple<TArguments...> arguments) {
+            std::true_type,
+            TCallback& callback,
+            TTuple& arguments) {
             // Call callback with the extracted arguments.
-            return callback(std::forward<TArguments>(std::get<S>(
-                arguments))...);
+            callback(std::forward<TArguments>(std::get<S>(arguments))...);
         }
 
     public:
@@ -58,19 +88,33 @@ class Apply {
         /// Calls the provided callback with the arguments in the provided
         /// tuple.
         ///
-        /// @param callback The function to call.
+        /// Neither the callback nor the arguments are copied. Arguments that
+        /// are not references are moved to the callback, which means they
+        /// should not be used afterwards.
+        ///
+        /// The callback may be any callable, such as a lambda stored with its
+        /// own type, which lets it be called directly. The tuple may either
+        /// contain the arguments or rvalue references to them, as created by
+        /// std::forward_as_tuple.
+        ///
+        /// @param callback The callable to call.
         /// @param arguments The arguments to call the callback with.
-        /// @return The return value from the callback.
-        /// @tparam TReturn The return type of the callback.
-        /// @tparam TArguments The types of the arguments of the callback.
-        template<typename TReturn, typename ...TArguments>
-        static TReturn apply(
-            std::function<TReturn (TArguments...)> callback,
-            std::tuple<TArguments...> arguments) {
-            // Create a "gens" with the number of arguments.
-            return applyWithSeq(typename gens<sizeof...(TArguments)>::type(),
+        /// @return The return value from the callback implicitly converted to
+        /// TReturn, or nothing if TReturn is void.
+        /// @tparam TReturn The return type.
+        /// @tparam TArguments The types of the arguments.
+        /// @tparam TCallback The type of the callback.
+        /// @tparam TTuple The type of the tuple.
+        template<typename TReturn, typename ...TArguments, typename TCallback,
+            typename TTuple>
+        static TReturn apply(TCallback&& callback, TTuple& arguments) {
+            // Create a "gens" with the number of arguments and choose whether
+            // to discard the return value.
+            return applyWithSeq<TReturn, TArguments...>(
+                typename gens<sizeof...(TArguments)>::type(),
+                typename std::is_void<TReturn>::type(),
                 callback,
-                std::move(arguments));
+                arguments);
         }
 };
 
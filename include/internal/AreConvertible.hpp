@@ -0,0 +1,29 @@
+#pragma once
+
+#include <type_traits>
+
+namespace IMock {
+namespace Internal {
+
+/// Checks if every provided type can be implicitly converted to a target type.
+///
+/// @tparam TTarget The type to convert to.
+/// @tparam TValues The types to check.
+template <typename TTarget, typename ...TValues>
+struct AreConvertible;
+
+//! @cond Doxygen_Suppress
+template <typename TTarget>
+struct AreConvertible<TTarget> : std::true_type {
+};
+
+template <typename TTarget, typename TValue, typename ...TValues>
+struct AreConvertible<TTarget, TValue, TValues...>
+    : std::integral_constant<bool,
+        std::is_convertible<TValue, TTarget>::value
+        && AreConvertible<TTarget, TValues...>::value> {
+};
+//! @endcond
+
+}
+}
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <MemoryResource.hpp>
+
+namespace IMock {
+namespace Internal {
+
+/// A deleter for values created in an Arena, which only destructs the values
+/// since their memory is released together with the Arena.
+struct ArenaDeleter {
+    /// Destructs a value.
+    ///
+    /// @param value A pointer to the value to destruct.
+    /// @tparam TValue The type of the value.
+    template <typename TValue>
+    void operator () (TValue* value) const noexcept {
+        // Call the destructor without deallocating the memory.
+        value->~TValue();
+    }
+};
+
+/// A unique_ptr owning a value created in an Arena.
+///
+/// @tparam TValue The type of the value.
+template <typename TValue>
+using ArenaPointer = std::unique_ptr<TValue, ArenaDeleter>;
+
+/// Hands out memory by bumping a pointer through large blocks requested from a
+/// MemoryResource. Memory is never deallocated individually. Instead, every
+/// block is released at once when the Arena is destroyed, or kept for reuse
+/// when the Arena is reset.
+///
+/// An Arena must only be used by one thread at a time.
+class Arena {
+    private:
+        /// The header stored first in every block.
+        struct Block {
+            /// The block used before this one, or the next spare block, or
+            /// nullptr.
+            Block* previous;
+
+            /// The size of the block in bytes, including the header.
+            std::size_t size;
+        };
+
+        /// The size of the first block.
+        static const std::size_t firstBlockSize = 4096;
+
+        /// The size blocks stop doubling at.
+        static const std::size_t maxBlockSize = 1 << 20;
+
+        /// The MemoryResource blocks are requested from.
+        MemoryResource& _memoryResource;
+
+        /// The most recently allocated block or nullptr.
+        Block* _block;
+
+        /// Blocks kept by reset to be used again before new blocks are
+        /// requested, in the order they were first used, or nullptr.
+        Block* _spareBlock;
+
+        /// The first free byte of the current block.
+        char* _position;
+
+        /// The end of the current block.
+        char* _end;
+
+        /// The size of the next block to allocate unless a larger one is
+        /// needed.
+        std::size_t _nextBlockSize;
+
+        /// Gets the number of bytes needed to round a pointer up to a
+        /// multiple of the provided alignment.
+        ///
+        /// @param pointer The pointer to round up.
+        /// @param alignment The alignment, which must be a power of two.
+        /// @return The number of bytes to add to the pointer.
+        static std::size_t getPadding(char* pointer, std::size_t alignment) {
+            // Round up the address by adding the alignment minus one and then
+            // clearing the bits below the alignment.
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pointer);
+            std::uintptr_t alignedAddress = (address + alignment - 1)
+                & ~static_cast<std::uintptr_t>(alignment - 1);
+            return static_cast<std::size_t>(alignedAddress - address);
+        }
+
+        /// Requests a new block large enough to hold the provided number of
+        /// bytes with the provided alignment.
+        ///
+        /// @param size The number of bytes that must fit in the block.
+        /// @param alignment The alignment of the bytes.
+        void addBlock(std::size_t size, std::size_t alignment) {
+            // Get the size of a new block, which grows until it reaches
+            // maxBlockSize unless a larger block is needed.
+            std::size_t blockSize = _nextBlockSize;
+            std::size_t neededSize = sizeof(Block) + size + alignment;
+            if(blockSize < neededSize) {
+                blockSize = neededSize;
+            }
+
+            // Use the next spare block if it is large enough.
+            Block* block;
+            if(_spareBlock != nullptr && _spareBlock->size >= neededSize) {
+                block = _spareBlock;
+                _spareBlock = block->previous;
+            }
+
+            // Otherwise, allocate a new block.
+            else {
+                block = static_cast<Block*>(_memoryResource.allocate(
+                    blockSize,
+                    alignof(std::max_align_t)));
+                block->size = blockSize;
+
+                // Double the size of the next block.
+                if(_nextBlockSize < maxBlockSize) {
+                    _nextBlockSize *= 2;
+                }
+            }
+
+            // Link the block to the previous blocks.
+            block->previous = _block;
+
+            // Let allocations continue after the header of the new block.
+            _block = block;
+            _position = reinterpret_cast<char*>(block + 1);
+            _end = reinterpret_cast<char*>(block) + block->size;
+        }
+
+        /// Releases a list of blocks.
+        ///
+        /// @param block The first block in the list or nullptr.
+        void releaseBlocks(Block* block) noexcept {
+            // Release the blocks in the order they are linked.
+            while(block != nullptr) {
+                Block* previous = block->previous;
+                _memoryResource.deallocate(
+                    block,
+                    block->size,
+                    alignof(std::max_align_t));
+                block = previous;
+            }
+        }
+
+    public:
+        /// Creates an empty Arena.
+        ///
+        /// @param memoryResource The MemoryResource to request blocks from,
+        /// which must outlive the Arena.
+        Arena(MemoryResource& memoryResource)
+            : _memoryResource(memoryResource)
+            , _block(nullptr)
+            , _spareBlock(nullptr)
+            , _position(nullptr)
+            , _end(nullptr)
+            , _nextBlockSize(firstBlockSize) {
+        }
+
+        /// Arena cannot be copied.
+        Arena(const Arena&) = delete;
+
+        /// Arena cannot be copied.
+        Arena& operator = (const Arena&) = delete;
+
+        /// Destructs the Arena by releasing every block.
+        ///
+        /// Values created in the Arena must have been destructed before.
+        ~Arena() noexcept {
+            // Release the blocks in use and the spare blocks.
+            releaseBlocks(_block);
+            releaseBlocks(_spareBlock);
+        }
+
+        /// Makes the memory of every value created in the Arena available
+        /// again while keeping the blocks, which lets the Arena be filled
+        /// again without requesting any memory.
+        ///
+        /// Values created in the Arena must have been destructed before.
+        void reset() noexcept {
+            // Move the blocks in use to the spare blocks, which reverses them
+            // to the order they were first used in.
+            while(_block != nullptr) {
+                Block* previous = _block->previous;
+                _block->previous = _spareBlock;
+                _spareBlock = _block;
+                _block = previous;
+            }
+
+            // Let the next allocation take a spare block.
+            _position = nullptr;
+            _end = nullptr;
+        }
+
+        /// Allocates memory that stays allocated until the Arena is destroyed.
+        ///
+        /// @param size The number of bytes to allocate.
+        /// @param alignment The alignment of the memory, which must be a power
+        /// of two.
+        /// @return A pointer to the allocated memory.
+        void* allocate(std::size_t size, std::size_t alignment) {
+            // Get the padding needed to align the current position.
+            std::size_t padding = _block == nullptr
+                ? 0
+                : getPadding(_position, alignment);
+
+            // Request a new block if the padding and the memory do not fit in
+            // the current one. The sizes are compared instead of the aligned
+            // position, which may be past the end of the block.
+            if(_block == nullptr
+                || static_cast<std::size_t>(_end - _position)
+                    < padding + size) {
+                addBlock(size, alignment);
+                padding = getPadding(_position, alignment);
+            }
+
+            // Bump the position past the memory and return it.
+            char* memory = _position + padding;
+            _position = memory + size;
+            return memory;
+        }
+
+        /// Creates a value in the Arena.
+        ///
+        /// @param arguments The arguments used to create the value.
+        /// @return An ArenaPointer owning the value.
+        /// @tparam TValue The type of the value to create.
+        /// @tparam TArguments The types of the arguments used to create the
+        /// value.
+        template <typename TValue, typename ...TArguments>
+        ArenaPointer<TValue> create(TArguments&&... arguments) {
+            // Allocate memory for the value.
+            void* memory = allocate(sizeof(TValue), alignof(TValue));
+
+            // Create the value in the memory. If the constructor throws, the
+            // memory is simply left unused.
+            return ArenaPointer<TValue>(
+                new(memory) TValue(std::forward<TArguments>(arguments)...));
+        }
+};
+
+}
+}
@@ -0,0 +1,431 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <internal/SegmentedVector.hpp>
+
+namespace IMock {
+namespace Internal {
+
+/// Checks if a type can be hashed using std::hash.
+///
+/// @tparam TValue The type to check.
+template <typename TValue>
+class IsHashable {
+    private:
+        // A trick to see if std::hash can be called with a value. The solution
+        // is based on the one used by ToString::is_streamable.
+        template <typename TT>
+        static auto test(int) -> decltype(
+            std::hash<TT>()(std::declval<const TT&>()),
+            std::true_type());
+
+        template <typename>
+        static auto test(...) -> std::false_type;
+
+    public:
+        static const bool value = decltype(test<TValue>(0))::value;
+};
+
+/// Checks if mock cases for a method with the provided argument types can be
+/// indexed by their arguments.
+///
+/// Reference arguments are never indexed as the referenced values may change
+/// after the mock case has been added, which would make the index stale.
+///
+/// @tparam TArguments The types of the arguments of the method.
+template <typename ...TArguments>
+struct IsIndexable;
+
+//! @cond Doxygen_Suppress
+template <>
+struct IsIndexable<> : std::true_type {
+};
+
+template <typename TArgument, typename ...TArguments>
+struct IsIndexable<TArgument, TArguments...> : std::integral_constant<bool,
+    !std::is_reference<TArgument>::value
+    && IsHashable<TArgument>::value
+    && IsIndexable<TArguments...>::value> {
+};
+//! @endcond
+
+/// Maps argument tuples to values using a hash table.
+///
+/// Only pointers to the argument tuples are stored, which means the tuples
+/// must be kept alive for as long as the index is used.
+///
+/// One thread at a time may insert values while other threads look values up
+/// without any locking.
+///
+/// @tparam TValue The type of the values to map the argument tuples to, which
+/// must be trivially copyable.
+/// @tparam indexable Whether the arguments can be indexed. If they can't, the
+/// index stays empty and every lookup fails.
+/// @tparam TArguments The types of the arguments of the mocked method.
+template <typename TValue, bool indexable, typename ...TArguments>
+class ArgumentsIndex;
+
+/// An ArgumentsIndex for arguments that can be indexed.
+///
+/// The hash table uses open addressing with linear probing. Entries are never
+/// removed and the tables replaced when the hash table grows are kept until
+/// the index is destroyed, which lets lookups run concurrently with
+/// insertions.
+///
+/// @tparam TValue The type of the values to map the argument tuples to.
+/// @tparam TArguments The types of the arguments of the mocked method.
+template <typename TValue, typename ...TArguments>
+class ArgumentsIndex<TValue, true, TArguments...> {
+    private:
+        /// An entry in the hash table mapping an argument tuple to a value.
+        struct Entry {
+            /// The argument tuple of the entry.
+            const std::tuple<TArguments...>* arguments;
+
+            /// The hash of the argument tuple.
+            std::size_t hash;
+
+            /// The value the argument tuple is mapped to.
+            std::atomic<TValue> value;
+
+            /// Creates an Entry.
+            ///
+            /// @param arguments The argument tuple of the entry.
+            /// @param hash The hash of the argument tuple.
+            /// @param value The value the argument tuple is mapped to.
+            Entry(
+                const std::tuple<TArguments...>* arguments,
+                std::size_t hash,
+                TValue value)
+                : arguments(arguments)
+                , hash(hash)
+                , value(value) {
+            }
+        };
+
+        /// A hash table of pointers to entries.
+        struct Table {
+            /// The number of slots minus one, which is used to map hashes to
+            /// slots as the number of slots is a power of two.
+            std::size_t mask;
+
+            /// The slots of the table, which are nullptr if empty.
+            std::unique_ptr<std::atomic<Entry*>[]> slots;
+
+            /// The table this table replaced, which is kept alive since other
+            /// threads may still be reading it.
+            std::unique_ptr<Table> previous;
+
+            /// Creates an empty Table.
+            ///
+            /// @param slotCount The number of slots, which must be a power of
+            /// two.
+            /// @param previous The table this table replaces.
+            Table(std::size_t slotCount, std::unique_ptr<Table> previous)
+                : mask(slotCount - 1)
+                , slots(new std::atomic<Entry*>[slotCount])
+                , previous(std::move(previous)) {
+                // Mark every slot as empty.
+                for(std::size_t slot = 0; slot < slotCount; slot++) {
+                    slots[slot].store(nullptr, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        /// Combines the hashes of the elements in an argument tuple, starting
+        /// with the element with the provided index.
+        ///
+        /// @tparam index The index of the first element to hash.
+        /// @tparam end Whether the index is past the last element.
+        template <std::size_t index,
+            bool end = index == sizeof...(TArguments)>
+        struct TupleHash {
+            /// Hashes the elements of the tuple starting at index.
+            ///
+            /// @param arguments The tuple to hash.
+            /// @return The combined hash of the elements.
+            /// @tparam TTuple The type of the tuple, which contains either the
+            /// arguments or references to them.
+            template <typename TTuple>
+            static std::size_t hash(const TTuple& arguments) {
+                // Get the type of the current element.
+                typedef typename std::tuple_element<
+                    index,
+                    std::tuple<TArguments...>>::type Element;
+
+                // Hash the current element.
+                std::size_t elementHash = std::hash<Element>()(
+                    std::get<index>(arguments));
+
+                // Combine it with the hash of the remaining elements using the
+                // same mixing step as boost::hash_combine.
+                std::size_t restHash = TupleHash<index + 1>::hash(arguments);
+                return restHash ^ (elementHash + 0x9e3779b9
+                    + (restHash << 6) + (restHash >> 2));
+            }
+        };
+
+        //! @cond Doxygen_Suppress
+        template <std::size_t index>
+        struct TupleHash<index, true> {
+            template <typename TTuple>
+            static std::size_t hash(const TTuple&) {
+                return 0;
+            }
+        };
+        //! @endcond
+
+        /// The entries of the hash table, which are stored separately to keep
+        /// them at the same address when the table grows.
+        SegmentedVector<Entry> _entries;
+
+        /// The current table.
+        std::atomic<Table*> _table;
+
+        /// Owns the current table, which in turn owns the previous tables.
+        std::unique_ptr<Table> _ownedTable;
+
+        /// Hashes an argument tuple.
+        ///
+        /// @param arguments The argument tuple to hash.
+        /// @return The hash of the argument tuple.
+        /// @tparam TTuple The type of the tuple, which contains either the
+        /// arguments or references to them.
+        template <typename TTuple>
+        static std::size_t hash(const TTuple& arguments) {
+            // Hash the elements and spread the bits using the finalizer of
+            // MurmurHash3 since many std::hash implementations return integers
+            // unchanged, which would make linear probing cluster.
+            unsigned long long hash = TupleHash<0>::hash(arguments);
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL;
+            hash ^= hash >> 33;
+            hash *= 0xc4ceb9fe1a85ec53ULL;
+            hash ^= hash >> 33;
+            return static_cast<std::size_t>(hash);
+        }
+
+        /// Stores a pointer to an entry in the first free slot of a table.
+        ///
+        /// @param table The table to store the entry in.
+        /// @param entry The entry to store.
+        static void store(Table& table, Entry* entry) {
+            // Probe the slots starting at the entry's hash until a free slot
+            // is found.
+            std::size_t slot = entry->hash & table.mask;
+            while(table.slots[slot].load(std::memory_order_relaxed)
+                != nullptr) {
+                slot = (slot + 1) & table.mask;
+            }
+
+            // Publish the entry in the free slot.
+            table.slots[slot].store(entry, std::memory_order_release);
+        }
+
+        /// Replaces the current table with a larger table.
+        ///
+        /// @param slotCount The number of slots of the new table, which must
+        /// be a power of two.
+        void grow(std::size_t slotCount) {
+            // Create the new table, which keeps the current table alive.
+            std::unique_ptr<Table> table(new Table(
+                slotCount,
+                std::move(_ownedTable)));
+
+            // Store every existing entry in the new table.
+            for(std::size_t entry = 0; entry < _entries.size(); entry++) {
+                store(*table, &_entries[entry]);
+            }
+
+            // Publish the new table.
+            _table.store(table.get(), std::memory_order_release);
+            _ownedTable = std::move(table);
+        }
+
+    public:
+        /// Creates an empty ArgumentsIndex.
+        ArgumentsIndex()
+            : _table(nullptr) {
+        }
+
+        /// Makes room for the provided number of additional argument tuples,
+        /// which lets them be inserted without the table growing more than
+        /// once.
+        ///
+        /// @param count The number of argument tuples to make room for.
+        void reserve(std::size_t count) {
+            // Get the number of slots keeping the table at most half full.
+            std::size_t slotCount = 16;
+            while(slotCount < (_entries.size() + count) * 2) {
+                slotCount *= 2;
+            }
+
+            // Grow the table if it is smaller than that.
+            if(_ownedTable == nullptr || _ownedTable->mask + 1 < slotCount) {
+                grow(slotCount);
+            }
+        }
+
+        /// Removes every argument tuple while keeping the current table and
+        /// the storage of the entries.
+        ///
+        /// This must not be called while other threads look values up.
+        void clear() noexcept {
+            // Remove the entries.
+            _entries.clear();
+
+            // Return if no table has been created.
+            Table* table = _ownedTable.get();
+            if(table == nullptr) {
+                return;
+            }
+
+            // Mark every slot as empty.
+            for(std::size_t slot = 0; slot <= table->mask; slot++) {
+                table->slots[slot].store(nullptr, std::memory_order_relaxed);
+            }
+
+            // Release the tables the current table replaced, which no thread
+            // reads anymore.
+            table->previous.reset();
+        }
+
+        /// Maps the provided arguments to the provided value, replacing any
+        /// value previously mapped to equal arguments.
+        ///
+        /// @param arguments The arguments to map, which must be kept alive for
+        /// as long as the index is used.
+        /// @param value The value to map the arguments to.
+        /// @return True since the arguments could be indexed.
+        bool insert(
+            const std::tuple<TArguments...>& arguments,
+            TValue value) {
+            // Hash the arguments.
+            std::size_t argumentsHash = hash(arguments);
+
+            // Check if an entry for the arguments already exists.
+            Table* table = _ownedTable.get();
+            if(table != nullptr) {
+                // Probe the slots starting at the hash until an empty slot is
+                // found.
+                for(std::size_t slot = argumentsHash & table->mask;;
+                    slot = (slot + 1) & table->mask) {
+                    // Get the entry in the slot.
+                    Entry* entry = table->slots[slot].load(
+                        std::memory_order_relaxed);
+
+                    // Stop probing if the slot is empty.
+                    if(entry == nullptr) {
+                        break;
+                    }
+
+                    // Check if the entry has equal arguments.
+                    if(entry->hash == argumentsHash
+                        && *entry->arguments == arguments) {
+                        // If so, replace its value.
+                        entry->value.store(value, std::memory_order_release);
+                        return true;
+                    }
+                }
+            }
+
+            // Make sure the table is at most half full after the insertion.
+            if(table == nullptr
+                || (_entries.size() + 1) * 2 > table->mask + 1) {
+                grow(table == nullptr ? 16 : (table->mask + 1) * 2);
+            }
+
+            // Create and store an entry for the arguments.
+            store(*_ownedTable, &_entries.emplaceBack(
+                &arguments,
+                argumentsHash,
+                value));
+
+            // Report that the arguments were indexed.
+            return true;
+        }
+
+        /// Gets the value mapped to the provided arguments.
+        ///
+        /// @param arguments References to the arguments to look up, which
+        /// are neither copied nor moved.
+        /// @param value Assigned the mapped value if one is found.
+        /// @return True if a value has been mapped to the arguments and false
+        /// otherwise.
+        bool find(
+            const std::tuple<TArguments&&...>& arguments,
+            TValue& value) const {
+            // Get the current table.
+            Table* table = _table.load(std::memory_order_acquire);
+
+            // Return immediately if the index is empty to not hash the
+            // arguments needlessly.
+            if(table == nullptr) {
+                return false;
+            }
+
+            // Hash the arguments.
+            std::size_t argumentsHash = hash(arguments);
+
+            // Probe the slots starting at the hash.
+            for(std::size_t slot = argumentsHash & table->mask;;
+                slot = (slot + 1) & table->mask) {
+                // Get the entry in the slot.
+                Entry* entry = table->slots[slot].load(
+                    std::memory_order_acquire);
+
+                // Report that no value was found if the slot is empty.
+                if(entry == nullptr) {
+                    return false;
+                }
+
+                // Check if the entry has equal arguments.
+                if(entry->hash == argumentsHash
+                    && *entry->arguments == arguments) {
+                    // If so, assign its value and report that it was found.
+                    value = entry->value.load(std::memory_order_acquire);
+                    return true;
+                }
+            }
+        }
+};
+
+/// An ArgumentsIndex for arguments that can't be indexed.
+///
+/// @tparam TValue The type of the values to map the argument tuples to.
+/// @tparam TArguments The types of the arguments of the mocked method.
+template <typename TValue, typename ...TArguments>
+class ArgumentsIndex<TValue, false, TArguments...> {
+    public:
+        /// Does nothing since the arguments can't be indexed.
+        void reserve(std::size_t) {
+        }
+
+        /// Does nothing since the arguments can't be indexed.
+        void clear() noexcept {
+        }
+
+        /// Does nothing since the arguments can't be indexed.
+        ///
+        /// @return False since the arguments could not be indexed.
+        bool insert(const std::tuple<TArguments...>&, TValue) {
+            return false;
+        }
+
+        /// Does nothing since the arguments can't be indexed.
+        ///
+        /// @return Always false.
+        bool find(const std::tuple<TArguments&&...>&, TValue&) const {
+            return false;
+        }
+};
+
+}
+}
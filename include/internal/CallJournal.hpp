@@ -0,0 +1,340 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <internal/CallString.hpp>
+#include <internal/IsCharacterPointer.hpp>
+#include <Concurrency.hpp>
+#include <JournalEntry.hpp>
+
+namespace IMock {
+namespace Internal {
+
+/// The settings of the journal of a mock, which are shared by the CallJournal
+/// instances of its methods.
+struct CallJournalSettings {
+    /// The number of calls to keep for every method.
+    std::size_t capacity;
+
+    /// Only one in this many calls is recorded.
+    std::size_t sampleInterval;
+
+    /// Whether calls may be made by several threads at once.
+    Concurrency concurrency;
+
+    /// The number of calls made since the journal was enabled, which is used
+    /// to give calls their sequence numbers.
+    std::atomic<std::uint64_t> callCount;
+
+    /// Creates CallJournalSettings.
+    ///
+    /// @param capacity The number of calls to keep for every method.
+    /// @param sampleInterval Only one in this many calls is recorded.
+    /// @param concurrency Whether calls may be made by several threads at
+    /// once.
+    CallJournalSettings(
+        std::size_t capacity,
+        std::size_t sampleInterval,
+        Concurrency concurrency)
+        : capacity(capacity)
+        , sampleInterval(sampleInterval)
+        , concurrency(concurrency)
+        , callCount(0) {
+    }
+
+    /// Gets the sequence number of a new call.
+    ///
+    /// @return The sequence number.
+    std::uint64_t nextSequenceNumber() {
+        // Use an atomic read-modify-write operation only if several threads
+        // may make calls at once.
+        if(concurrency == Concurrency::Concurrent) {
+            return callCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Otherwise, increase the call count as cheaply as a plain integer.
+        std::uint64_t sequenceNumber
+            = callCount.load(std::memory_order_relaxed);
+        callCount.store(sequenceNumber + 1, std::memory_order_relaxed);
+        return sequenceNumber;
+    }
+};
+
+/// Placeholder recorded in place of an argument that can't be copied, which
+/// is shown as a question mark.
+struct UncopyableArgument {
+    /// Creates an UncopyableArgument from any argument.
+    template <typename TArgument>
+    UncopyableArgument(const TArgument&) {
+    }
+};
+
+/// A copy of the characters a pointer to characters points to, which is
+/// recorded in place of the pointer since the characters may have been freed
+/// when the journal is read.
+struct RecordedCharacters {
+    /// The copied characters, which are empty if the pointer was null.
+    std::string characters;
+
+    /// Creates a RecordedCharacters by copying the characters up to the
+    /// terminating null character.
+    ///
+    /// @param pointer A pointer to the characters, which may be null.
+    /// @tparam TCharacter The type of the characters.
+    template <typename TCharacter>
+    RecordedCharacters(const TCharacter* pointer)
+        : characters(pointer != nullptr
+            ? reinterpret_cast<const char*>(pointer)
+            : "") {
+    }
+};
+
+/// Appends recorded characters to a stream as if they were the C string they
+/// were copied from.
+///
+/// @param out The stream to append the characters to.
+/// @param characters The recorded characters.
+/// @return The stream.
+inline std::ostream& operator << (
+    std::ostream& out,
+    const RecordedCharacters& characters) {
+    // Append the characters.
+    return out << characters.characters;
+}
+
+/// Decides how an argument is recorded in a CallJournal. Pointers to
+/// characters are recorded as RecordedCharacters, other arguments that can be
+/// copied are recorded as copies and the remaining arguments are recorded as
+/// UncopyableArgument.
+///
+/// @tparam TArgument The type of the argument.
+template <typename TArgument>
+struct RecordedArgument {
+    /// The type the argument is recorded as.
+    typedef typename std::conditional<
+        IsCharacterPointer<typename std::decay<TArgument>::type>::value,
+        RecordedCharacters,
+        typename std::conditional<
+            std::is_copy_constructible<
+                typename std::decay<TArgument>::type>::value,
+            typename std::decay<TArgument>::type,
+            UncopyableArgument>::type>::type type;
+};
+
+/// A bounded ring buffer of the most recent calls to a mocked method.
+///
+/// The memory for the calls is allocated up front, which makes recording a
+/// call no more expensive than copying its arguments. Calls may be recorded by
+/// several threads at once, while the journal must only be read when no calls
+/// are being made.
+///
+/// @tparam TArguments The types of the arguments of the mocked method.
+template <typename ...TArguments>
+class CallJournal {
+    private:
+        /// The type the arguments of a call are recorded as.
+        typedef std::tuple<typename RecordedArgument<TArguments>::type...>
+            RecordedArguments;
+
+        /// A position in the ring buffer.
+        struct Slot {
+            /// Zero if the slot is empty, busyState while it is being written
+            /// and otherwise the sequence number of the recorded call plus
+            /// one.
+            std::atomic<std::uint64_t> state;
+
+            /// Storage for the recorded arguments, which are created the
+            /// first time the slot is written.
+            typename std::aligned_storage<
+                sizeof(RecordedArguments),
+                alignof(RecordedArguments)>::type arguments;
+
+            /// Gets the recorded arguments.
+            ///
+            /// @return A reference to the recorded arguments.
+            RecordedArguments& getArguments() {
+                // Cast the storage to the recorded arguments.
+                return *reinterpret_cast<RecordedArguments*>(&arguments);
+            }
+        };
+
+        /// The state of a slot that is being written.
+        static const std::uint64_t busyState = ~std::uint64_t(0);
+
+        /// The settings of the journal.
+        CallJournalSettings& _settings;
+
+        /// The slots of the ring buffer.
+        std::unique_ptr<Slot[]> _slots;
+
+        /// The number of calls recorded, which decides the next slot to
+        /// write.
+        std::atomic<std::size_t> _recordCount;
+
+        /// The number of calls that were not recorded since another thread
+        /// was writing the same slot.
+        std::atomic<std::size_t> _droppedCount;
+
+    public:
+        /// Creates an empty CallJournal.
+        ///
+        /// @param settings The settings of the journal, which must outlive the
+        /// CallJournal.
+        CallJournal(CallJournalSettings& settings)
+            : _settings(settings)
+            , _slots(new Slot[settings.capacity])
+            , _recordCount(0)
+            , _droppedCount(0) {
+            // Mark every slot as empty.
+            for(std::size_t slot = 0; slot < _settings.capacity; slot++) {
+                _slots[slot].state.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /// CallJournal cannot be copied.
+        CallJournal(const CallJournal&) = delete;
+
+        /// CallJournal cannot be copied.
+        CallJournal& operator = (const CallJournal&) = delete;
+
+        /// Destructs the CallJournal and the recorded arguments.
+        ~CallJournal() noexcept {
+            // Destruct the arguments in every slot that has been written.
+            for(std::size_t slot = 0; slot < _settings.capacity; slot++) {
+                if(_slots[slot].state.load(std::memory_order_relaxed) != 0) {
+                    _slots[slot].getArguments().~RecordedArguments();
+                }
+            }
+        }
+
+        /// Removes every recorded call.
+        ///
+        /// This must not be called while calls are being made.
+        void clear() noexcept {
+            // Destruct the arguments in every slot that has been written and
+            // mark the slot as empty.
+            for(std::size_t slot = 0; slot < _settings.capacity; slot++) {
+                if(_slots[slot].state.load(std::memory_order_relaxed) != 0) {
+                    _slots[slot].getArguments().~RecordedArguments();
+                    _slots[slot].state.store(0, std::memory_order_relaxed);
+                }
+            }
+
+            // Start recording from the first slot again.
+            _recordCount.store(0, std::memory_order_relaxed);
+            _droppedCount.store(0, std::memory_order_relaxed);
+        }
+
+        /// Records a call unless it is skipped by the sampling.
+        ///
+        /// @param arguments References to the arguments of the call, which are
+        /// copied.
+        void record(const std::tuple<TArguments&&...>& arguments) {
+            // Get the sequence number of the call and skip it unless it is
+            // sampled.
+            std::uint64_t sequenceNumber = _settings.nextSequenceNumber();
+            if(sequenceNumber % _settings.sampleInterval != 0) {
+                return;
+            }
+
+            // Get the slot to write, overwriting the oldest call when the ring
+            // buffer is full.
+            std::size_t recordIndex;
+            if(_settings.concurrency == Concurrency::Concurrent) {
+                recordIndex = _recordCount.fetch_add(
+                    1,
+                    std::memory_order_relaxed);
+            }
+            else {
+                recordIndex = _recordCount.load(std::memory_order_relaxed);
+                _recordCount.store(
+                    recordIndex + 1,
+                    std::memory_order_relaxed);
+            }
+            Slot& slot = _slots[recordIndex % _settings.capacity];
+
+            // Get the state of the slot.
+            std::uint64_t state = slot.state.load(std::memory_order_acquire);
+
+            // In concurrent mode, claim the slot. The call is dropped if
+            // another thread is writing the slot, which only happens when
+            // more threads than the capacity write at once.
+            if(_settings.concurrency == Concurrency::Concurrent
+                && (state == busyState
+                    || !slot.state.compare_exchange_strong(
+                        state,
+                        busyState,
+                        std::memory_order_acquire))) {
+                _droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            // Destruct any previously recorded arguments instead of assigning
+            // to them, which also supports arguments that can be copied but
+            // not assigned.
+            if(state != 0) {
+                slot.getArguments().~RecordedArguments();
+            }
+
+            // Write the arguments, leaving the slot empty if copying them
+            // throws.
+            try {
+                new(&slot.arguments) RecordedArguments(arguments);
+            }
+            catch(...) {
+                slot.state.store(0, std::memory_order_release);
+                throw;
+            }
+
+            // Publish the call.
+            slot.state.store(sequenceNumber + 1, std::memory_order_release);
+        }
+
+        /// Appends a JournalEntry for every recorded call.
+        ///
+        /// @param methodString A string describing how a call is made to the
+        /// mocked method.
+        /// @param entries The vector to append the entries to.
+        void appendEntries(
+            const std::string& methodString,
+            std::vector<JournalEntry>& entries) const {
+            // Process every slot.
+            for(std::size_t slot = 0; slot < _settings.capacity; slot++) {
+                // Skip the slot if it is empty.
+                std::uint64_t state = _slots[slot].state.load(
+                    std::memory_order_acquire);
+                if(state == 0 || state == busyState) {
+                    continue;
+                }
+
+                // Create a call string from a copy of the arguments, which may
+                // be moved by CallString.
+                RecordedArguments arguments = _slots[slot].getArguments();
+                entries.push_back(JournalEntry{
+                    state - 1,
+                    CallString::create(methodString, arguments)
+                });
+            }
+        }
+
+        /// Gets the number of calls that were not recorded since another
+        /// thread was writing the same slot.
+        ///
+        /// @return The number of dropped calls.
+        std::size_t getDroppedCount() const {
+            // Return the number of dropped calls.
+            return _droppedCount.load(std::memory_order_relaxed);
+        }
+};
+
+}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <internal/Apply.hpp>
+#include <internal/JoinStrings.hpp>
+#include <internal/ToString.hpp>
+
+namespace IMock {
+namespace Internal {
+
+/// Creates strings describing how calls were made.
+class CallString {
+    public:
+        /// CallString is not supposed to be instantiated since it only
+        /// contains a static method.
+        CallString() = delete;
+
+        /// Create a call string from the provided method string and arguments.
+        ///
+        /// Arguments that are not references are moved, which means they
+        /// should not be used afterwards.
+        ///
+        /// @param methodString A string describing how a call is made to the
+        /// method.
+        /// @param arguments The arguments of the call.
+        /// @return A string describing how the call was made.
+        /// @tparam TArguments The types of the arguments.
+        template <typename ...TArguments>
+        static std::string create(
+            const std::string& methodString,
+            std::tuple<TArguments...>& arguments) {
+            // Convert the arguments to strings.
+            std::vector<std::string> stringArguments
+                = Apply::apply<std::vector<std::string>, TArguments...>(
+                    std::function<std::vector<std::string> (TArguments...)>(
+                        ToString::toStrings<TArguments...>),
+                    arguments);
+
+            // Join the argument strings.
+            std::string argumentsString = JoinStrings::joinStrings(
+                ", ",
+                std::move(stringArguments));
+
+            // Create a call string.
+            std::string callString
+                = methodString
+                + "(" + argumentsString + ")";
+
+            // Return the call string.
+            return callString;
+        }
+};
+
+}
+}
@@ -1,33 +1,32 @@
 #pragma once
 
-#include <memory>
-#include <utility>
-
 #include <internal/IReturnValue.hpp>
+#include <internal/StatisticsNamespace.hpp>
 
 namespace IMock {
 namespace Internal {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
 
 /// Indicates if a call to a mock case resulted in a match with a return value
 /// or if it resulted in no match.
+///
+/// A CaseMatch only refers to an IReturnValue owned by the mock case, which
+/// makes it cheap to create and to pass around.
+///
 /// @tparam TReturn The return type of the mocked method.
-template <typename TReturn>
+/// @tparam TArguments The types of the arguments of the mocked method.
+template <typename TReturn, typename ...TArguments>
 class CaseMatch {
     private:
         /// A possible return value.
-        std::unique_ptr<IReturnValue<TReturn>> _returnValue;
+        IReturnValue<TReturn, TArguments...>* _returnValue;
 
     public:
         /// Creates a CaseMatch.
         ///
         /// @param returnValue A possible return value.
-        CaseMatch(std::unique_ptr<IReturnValue<TReturn>> returnValue)
-            : _returnValue(std::move(returnValue)) {
-        }
-
-        /// Move constructor for CaseMatch.
-        CaseMatch(CaseMatch&& other)
-            : _returnValue(std::move(other._returnValue)) {
+        CaseMatch(IReturnValue<TReturn, TArguments...>* returnValue)
+            : _returnValue(returnValue) {
         }
 
         /// Indicates if the call resulted in a match.
@@ -35,18 +34,19 @@ class CaseMatch {
         /// @return True if the call resulted in a match and false otherwise.
         bool isMatch() const {
             // A match happened if the a return value exists.
-            return _returnValue.get() != nullptr;
+            return _returnValue != nullptr;
         }
 
         /// Gets the return value. Calling this on an instance where isMatch()
         /// returns false results in a segmentation fault.
         ///
         /// @return The return value.
-        IReturnValue<TReturn>& getReturnValue() const {
+        IReturnValue<TReturn, TArguments...>& getReturnValue() const {
             // Get and return the return value.
-            return *_returnValue.get();
+            return *_returnValue;
         }
 };
 
+IMOCK_STATISTICS_NAMESPACE_END
 }
 }
@@ -3,9 +3,11 @@
 #include <tuple>
 
 #include <internal/CaseMatch.hpp>
+#include <internal/StatisticsNamespace.hpp>
 
 namespace IMock {
 namespace Internal {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
 
 /// Interface for a mocked case.
 ///
@@ -20,13 +22,32 @@ class ICase {
 
         /// Checks if the provided arguments matches the case.
         ///
-        /// @param arguments The arguments the mocked method was called with.
-        /// The arguments will never be used again if the function indicates a
-        /// match, which means the values can safely be moved.
+        /// @param arguments References to the arguments the mocked method was
+        /// called with, which avoids copying or moving them.
         /// @return A CaseMatch indicating if the arguments resulted in a match.
-        virtual CaseMatch<TReturn> matches(std::tuple<Arguments...>& arguments)
-            = 0;
+        virtual CaseMatch<TReturn, Arguments...> matches(
+            std::tuple<Arguments&&...>& arguments) = 0;
+
+        /// Gets the arguments calls must be equal to for the case to match.
+        ///
+        /// @return A pointer to the arguments or nullptr if the case does not
+        /// require calls to have specific arguments.
+        virtual const std::tuple<Arguments...>* getArguments() const {
+            // Return nullptr by default.
+            return nullptr;
+        }
+
+        /// Checks if the case matches every call regardless of its arguments,
+        /// which lets calls skip looking at older mock cases while it is the
+        /// most recently added one.
+        ///
+        /// @return True if the case matches every call.
+        virtual bool matchesEveryCall() const {
+            // Return false by default.
+            return false;
+        }
 };
 
+IMOCK_STATISTICS_NAMESPACE_END
 }
 }
@@ -1,5 +1,12 @@
 #pragma once
 
+#include <vector>
+
+#include <internal/Arena.hpp>
+#include <internal/CallJournal.hpp>
+#include <JournalEntry.hpp>
+#include <MethodStatistics.hpp>
+
 namespace IMock {
 namespace Internal {
 
@@ -10,6 +17,34 @@ class IMockMethodNonGeneric {
         /// Virtual destructor of IMockMethodNonGeneric.
         virtual ~IMockMethodNonGeneric() noexcept {
         }
+
+        /// Starts recording calls to the method in a journal.
+        ///
+        /// @param settings The settings of the journal, which must outlive
+        /// the method.
+        /// @param arena The Arena to create the journal in.
+        virtual void enableJournal(
+            CallJournalSettings& settings,
+            Arena& arena) = 0;
+
+        /// Removes every mock case and recorded call while keeping the memory
+        /// used to store them.
+        ///
+        /// This must not be called while calls are being made.
+        virtual void reset() = 0;
+
+        /// Appends a JournalEntry for every recorded call to the method.
+        ///
+        /// @param entries The vector to append the entries to.
+        virtual void appendJournalEntries(
+            std::vector<JournalEntry>& entries) const = 0;
+
+        /// Appends MethodStatistics describing how calls to the method have
+        /// been handled, unless statistics are disabled.
+        ///
+        /// @param statistics The vector to append the MethodStatistics to.
+        virtual void appendStatistics(
+            std::vector<MethodStatistics>& statistics) const = 0;
 };
 
 }
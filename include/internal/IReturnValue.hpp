@@ -1,43 +1,62 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
+#include <exception/ReturnValuesExhaustedException.hpp>
 #include <internal/Apply.hpp>
+#include <internal/MethodStatisticsRecorder.hpp>
+#include <internal/StatisticsNamespace.hpp>
 
 namespace IMock {
 namespace Internal {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
 
 /// Interface for retrieving a return value.
 ///
+/// Instances are created when a mock case is added and are reused for every
+/// call matching the mock case, which means no memory has to be allocated when
+/// a call is made.
+///
 /// @tparam TReturn The return type of the mocked method.
-template <typename TReturn>
+/// @tparam TArguments The types of the arguments of the mocked method.
+template <typename TReturn, typename ...TArguments>
 class IReturnValue {
     public:
         /// Virtual destructor of IReturnValue.
         virtual ~IReturnValue() noexcept {
         }
 
-        /// Gets the return value.
-        ///
-        /// NOTICE: The method can only be called once for each instance.
-        /// Any subsequent calls may result in an exception being thrown.
+        /// Gets the return value of a call.
         ///
+        /// @param arguments References to the arguments the mocked method was
+        /// called with. The arguments will never be used again, which means
+        /// the values can safely be moved.
         /// @return The return value.
-        virtual TReturn getReturnValue() = 0;
+        virtual TReturn getReturnValue(
+            std::tuple<TArguments&&...>& arguments) = 0;
 };
 
 /// Implements IReturnValue to make getReturnValue return void.
-class VoidReturnValue : public IReturnValue<void> {
+///
+/// @tparam TArguments The types of the arguments of the mocked method.
+template <typename ...TArguments>
+class VoidReturnValue : public IReturnValue<void, TArguments...> {
     public:
-        virtual void getReturnValue() override {
+        virtual void getReturnValue(std::tuple<TArguments&&...>&) override {
         }
 };
 
 /// Implements IReturnValue to make getReturnValue return the provided value.
 ///
 /// @tparam TReturn The return type of the mocked method.
-template <typename TReturn>
-class NonVoidReturnValue : public IReturnValue<TReturn> {
+/// @tparam TArguments The types of the arguments of the mocked method.
+template <typename TReturn, typename ...TArguments>
+class NonVoidReturnValue : public IReturnValue<TReturn, TArguments...> {
     private:
         /// The value to return.
         TReturn _returnValue;
@@ -50,43 +69,147 @@ class NonVoidReturnValue : public IReturnValue<TReturn> {
             : _returnValue(std::forward<TReturn>(returnValue)) {
         }
         
-        virtual TReturn getReturnValue() override {
+        virtual TReturn getReturnValue(std::tuple<TArguments&&...>&)
+            override {
             // Return the stored value.
             return _returnValue;
         }
 };
 
-/// Implements FakeReturnValue to make getReturnValue call the provided fake
-/// with the provided arguments and return its return value.
+/// Implements IReturnValue to make getReturnValue return the provided values
+/// in order, one per call.
+///
+/// The values are stored contiguously and the next one is found in constant
+/// time. The values are either returned in order after which the last value
+/// is copied for every following call, or moved out once each.
 ///
+/// @tparam repeatLast Whether the last value is returned forever, which
+/// requires it to be copied. Otherwise, every value is moved out once.
 /// @tparam TReturn The return type of the mocked method.
 /// @tparam TArguments The types of the arguments of the mocked method.
-template <typename TReturn, typename ...TArguments>
-class FakeReturnValue : public IReturnValue<TReturn> {
+template <bool repeatLast, typename TReturn, typename ...TArguments>
+class SequenceReturnValue : public IReturnValue<TReturn, TArguments...> {
+    public:
+        /// The type the values are stored as, which wraps references to make
+        /// them storable in a vector.
+        typedef typename std::conditional<
+            std::is_lvalue_reference<TReturn>::value,
+            std::reference_wrapper<
+                typename std::remove_reference<TReturn>::type>,
+            TReturn>::type StoredValue;
+
+    private:
+        /// Whether the last value is returned forever.
+        typedef std::integral_constant<bool, repeatLast> RepeatsLast;
+
+        /// The values to return.
+        std::vector<StoredValue> _returnValues;
+
+        /// The number of calls that have taken a value, which stops
+        /// increasing at the last value if it is returned forever.
+        std::atomic<std::size_t> _callIndex;
+
+        /// Gets the value for a call by copying it.
+        ///
+        /// @param callIndex The index of the call.
+        /// @return The value.
+        TReturn takeReturnValue(std::size_t callIndex, std::true_type) {
+            // Return the value, or the last value when every value has been
+            // returned.
+            return _returnValues[callIndex < _returnValues.size()
+                ? callIndex
+                : _returnValues.size() - 1];
+        }
+
+        /// Gets the value for a call by moving it.
+        ///
+        /// @param callIndex The index of the call.
+        /// @return The value.
+        /// @throws Throws a ReturnValuesExhaustedException if every value has
+        /// already been returned.
+        TReturn takeReturnValue(std::size_t callIndex, std::false_type) {
+            // Check if every value has already been moved out.
+            if(callIndex >= _returnValues.size()) {
+                throw Exception::ReturnValuesExhaustedException();
+            }
+
+            // Move the value out since it is never returned again.
+            return std::move(_returnValues[callIndex]);
+        }
+
+    public:
+        /// Creates a SequenceReturnValue.
+        ///
+        /// @param returnValues The values to return, which must not be empty.
+        SequenceReturnValue(std::vector<StoredValue> returnValues)
+            : _returnValues(std::move(returnValues))
+            , _callIndex(0) {
+        }
+
+        virtual TReturn getReturnValue(std::tuple<TArguments&&...>&)
+            override {
+            // Get the index of the call. Once the last value is reached, the
+            // index is no longer increased if the value is returned forever,
+            // which makes the remaining calls read it without a
+            // read-modify-write operation.
+            std::size_t callIndex = _callIndex.load(std::memory_order_relaxed);
+            if(!repeatLast || callIndex + 1 < _returnValues.size()) {
+                callIndex = _callIndex.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            // Get the value for the call.
+            return takeReturnValue(callIndex, RepeatsLast());
+        }
+};
+
+/// Implements IReturnValue to make getReturnValue call the provided fake
+/// with the call's arguments and return its return value.
+///
+/// The fake is stored with its own type, which means it is created in the
+/// Arena together with the FakeReturnValue instead of being allocated
+/// separately and is called without any indirection. If IMOCK_STATISTICS is
+/// defined, the time taken by every call to the fake is recorded in the
+/// statistics of the mocked method.
+///
+/// @tparam TFake The type of the fake.
+/// @tparam TReturn The return type of the mocked method.
+/// @tparam TArguments The types of the arguments of the mocked method.
+template <typename TFake, typename TReturn, typename ...TArguments>
+class FakeReturnValue : public IReturnValue<TReturn, TArguments...> {
     private:
         /// The fake to call.
-        std::function<TReturn (TArguments...)> _fake;
+        TFake _fake;
 
-        /// The arguments to call the fake with.
-        std::tuple<TArguments...> _arguments;
+        /// The statistics of the mocked method, which are referred to if
+        /// statistics are enabled and empty otherwise.
+        typename MethodStatisticsRecorder<statisticsEnabled>::Reference
+            _statistics;
 
     public:
         /// Creates a FakeReturnValue.
         ///
         /// @param fake The fake to call.
-        /// @param arguments The arguments to call the fake with.
+        /// @param statistics The statistics of the mocked method, which must
+        /// outlive the FakeReturnValue if statistics are enabled.
         FakeReturnValue(
-            std::function<TReturn (TArguments...)> fake,
-            std::tuple<TArguments...> arguments)
+            TFake fake,
+            typename MethodStatisticsRecorder<statisticsEnabled>::Reference
+                statistics)
             : _fake(std::move(fake))
-            , _arguments(std::move(arguments)) {
+            , _statistics(statistics) {
         }
 
-        virtual TReturn getReturnValue() override {
+        virtual TReturn getReturnValue(
+            std::tuple<TArguments&&...>& arguments) override {
+            // Measure the call if statistics are enabled.
+            typename MethodStatisticsRecorder<statisticsEnabled>::FakeTimer
+                timer(_statistics);
+
             // Forward the call to _fake.
-            return Apply::apply(_fake, std::move(_arguments));
+            return Apply::apply<TReturn, TArguments...>(_fake, arguments);
         }
 };
 
+IMOCK_STATISTICS_NAMESPACE_END
 }
 }
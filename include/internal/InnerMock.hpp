@@ -1,22 +1,49 @@
 #pragma once
 
-#include <functional>
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
 
+#include <exception/InvalidJournalSettingsException.hpp>
+#include <exception/JournalEnabledTwiceException.hpp>
+#include <exception/MethodMockedAfterCallsException.hpp>
+#include <exception/UnknownCallException.hpp>
+#include <internal/Arena.hpp>
+#include <internal/CallJournal.hpp>
 #include <internal/CaseMatch.hpp>
-#include <internal/makeUnique.hpp>
 #include <internal/MockMethod.hpp>
+#include <internal/NewDeleteMemoryResource.hpp>
+#include <internal/StatisticsNamespace.hpp>
 #include <internal/union_cast.hpp>
 #include <internal/VirtualTable.hpp>
+#include <internal/VirtualTableOffsetContext.hpp>
+#include <CallCounts.hpp>
+#include <Concurrency.hpp>
+#include <JournalEntry.hpp>
+#include <MemoryResource.hpp>
 #include <Method.hpp>
-#include <MockCaseID.hpp>
+#include <MethodStatistics.hpp>
 
 namespace IMock {
 namespace Internal {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
 
 /// Mocks a provided interface to perform wanted actions and return certain
 /// values when its virtual methods are called.
 ///
+/// In concurrent mode, calls are handled without locking while mock cases are
+/// added by one thread at a time.
+///
+/// The mock cases and MockMethod instances are stored in arenas, which makes
+/// adding them cheap and lets them be released at once. The mock cases have an
+/// Arena of their own, which lets the InnerMock be reset without releasing the
+/// MockMethod instances.
+///
 /// @tparam TInterface The type of interface to be mocked.
 template <typename TInterface>
 class InnerMock {
@@ -47,185 +74,628 @@ class InnerMock {
                 
                 /// Called when a call to a method in the interface is called.
                 ///
+                /// There is one onCall per mocked method, which makes it
+                /// possible to find the method's MockMethod using its virtual
+                /// table offset without any lookups.
+                ///
                 /// @param arguments The arguments the method was called with.
                 /// @return The return value from the first matching mock case.
                 /// @throws Throws an UnmockedCallException if the arguments
                 /// does not match any mock case.
-                ///
-                /// @return A MockWithID associated with the MockCaseID.
-                /// @tparam id The MockWithID used to identify the mock case
-                /// that first added a mock case to the method.
+                /// @tparam TMethod The type of the mocked method.
+                /// @tparam method The mocked method.
                 /// @tparam TReturn The return type of the mocked method.
                 /// @tparam TArguments The types of the arguments of the mocked
                 /// method.
-                template <MockCaseID id, typename TReturn,
+                template <typename TMethod, TMethod method, typename TReturn,
                     typename ...TArguments>
                 TReturn onCall(TArguments... arguments) {
-                    // Forward the call to _mock.onCall.
-                    return _mock.onCall<TReturn, TArguments...>(
-                        id,
-                        std::forward<TArguments>(arguments)...);
+                    // Get the virtual table offset of the method.
+                    VirtualTableOffset virtualTableOffset
+                        = VirtualTableOffsetContext::getVirtualTableOffset<
+                            TMethod, method>();
+
+                    // Get the MockMethod instances, which are created
+                    // together with the first mock case.
+                    std::atomic<IMockMethodNonGeneric*>* mockMethods
+                        = _mock._mockMethods.load(std::memory_order_acquire);
+
+                    // Get the MockMethod for the called method.
+                    IMockMethodNonGeneric* mockMethod = mockMethods == nullptr
+                        ? nullptr
+                        : mockMethods[virtualTableOffset].load(
+                            std::memory_order_acquire);
+
+                    // The MockMethod is only missing if a call reaches a
+                    // method whose first mock case is being added by another
+                    // thread without the InnerMock noticing, in which case the
+                    // method is treated as not mocked yet.
+                    if(mockMethod == nullptr) {
+                        throw Exception::UnknownCallException();
+                    }
+
+                    // Cast the MockMethod to its correct type and forward the
+                    // call to onCall.
+                    return static_cast<MockMethod<TReturn, TArguments...>&>(
+                        *mockMethod)
+                        .onCall(std::forward<TArguments>(arguments)...);
                 }
         };
 
-        /// Maps the MockCaseID's of all mock cases to the virtual table offsets
-        /// of their mocked methods.
-        std::map<MockCaseID, VirtualTableOffset> _virtualTableOffsets;
+    public:
+        /// Describes where a method is located in the virtual table and which
+        /// onCall method to insert into the virtual table to handle calls to
+        /// it.
+        ///
+        /// @tparam TReturn The return type of the method.
+        /// @tparam TArguments The types of the arguments to the method.
+        template <typename TReturn, typename ...TArguments>
+        struct MethodSlot {
+            /// The virtual table offset of the method.
+            VirtualTableOffset virtualTableOffset;
 
-        /// Maps the virtual table offsets of the mocked methods to MockMethod
-        /// instances dealing with calls to respective method.
-        std::map<VirtualTableOffset, std::unique_ptr<IMockMethodNonGeneric>>
-            _mockMethods;
+            /// The onCall method handling calls to the method.
+            Method<MockFake, TReturn, TArguments...> onCall;
+        };
 
+    private:
         /// A VirtualTable to add mocked methods to.
         VirtualTable<TInterface> _virtualTable;
 
+        /// The Arena containing the MockMethod instances and their journals,
+        /// which is declared before them to outlive them.
+        Arena _arena;
+
+        /// The Arena containing the mock cases and their return values, which
+        /// is reused when the InnerMock is reset.
+        Arena _caseArena;
+
+        /// Contains MockMethod instances dealing with calls to the mocked
+        /// methods at the index of their virtual table offsets. Methods that
+        /// have not been mocked have no MockMethod and are nullptr. The
+        /// MockMethod instances are owned by the InnerMock and stored in
+        /// _arena together with the array, which is created when the first
+        /// mock case is added to keep the InnerMock cheap to create. Until
+        /// then, it is nullptr.
+        std::atomic<std::atomic<IMockMethodNonGeneric*>*> _mockMethods;
+
         /// A MockFake used by the InnerMock.
         MockFake _mockFake;
 
+        /// Whether the InnerMock may be used by several threads at once.
+        Concurrency _concurrency;
+
+        /// Whether get() has been called in concurrent mode since the
+        /// InnerMock was created or reset. The virtual table is written
+        /// without synchronization when the first mock case of a method is
+        /// added, which is only done before then.
+        std::atomic<bool> _callsStarted;
+
+        /// Serializes additions of mock cases and uses of the arenas in
+        /// concurrent mode.
+        std::mutex _addCaseMutex;
+
+        /// The settings of the journal, or nullptr if it is not enabled.
+        std::unique_ptr<CallJournalSettings> _journalSettings;
+
+        /// Locks _addCaseMutex in concurrent mode, which keeps single threaded
+        /// mocks free from synchronization.
+        ///
+        /// @return A lock that is released when destroyed.
+        std::unique_lock<std::mutex> lockInConcurrentMode() {
+            // Create a lock that is only locked in concurrent mode.
+            std::unique_lock<std::mutex> lock(_addCaseMutex, std::defer_lock);
+            if(_concurrency == Concurrency::Concurrent) {
+                lock.lock();
+            }
+
+            // Return the lock.
+            return lock;
+        }
+
+        /// Gets the MockMethod instances and creates them if needed, which
+        /// must only be done while adding a mock case.
+        ///
+        /// @return A pointer to the first MockMethod.
+        std::atomic<IMockMethodNonGeneric*>* getMockMethods() {
+            // Get the MockMethod instances and return them if they have been
+            // created.
+            std::atomic<IMockMethodNonGeneric*>* mockMethods
+                = _mockMethods.load(std::memory_order_relaxed);
+            if(mockMethods != nullptr) {
+                return mockMethods;
+            }
+
+            // Allocate the array in the Arena.
+            mockMethods = static_cast<std::atomic<IMockMethodNonGeneric*>*>(
+                _arena.allocate(
+                    _virtualTable.getSize()
+                        * sizeof(std::atomic<IMockMethodNonGeneric*>),
+                    alignof(std::atomic<IMockMethodNonGeneric*>)));
+
+            // Mark every method as not mocked.
+            for(VirtualTableOffset virtualTableOffset = 0;
+                virtualTableOffset < _virtualTable.getSize();
+                virtualTableOffset++) {
+                new(mockMethods + virtualTableOffset)
+                    std::atomic<IMockMethodNonGeneric*>(nullptr);
+            }
+
+            // Publish and return the array.
+            _mockMethods.store(mockMethods, std::memory_order_release);
+            return mockMethods;
+        }
+
+        /// Gets the statistics of the provided method, creating its MockMethod
+        /// if the method has no mock cases, when statistics are enabled.
+        ///
+        /// @param methodSlot The MethodSlot of the method.
+        /// @param methodString A string describing how a call is made to the
+        /// method.
+        /// @return The MethodStatisticsRecorder of the method.
+        /// @tparam TReturn The return type of the method.
+        /// @tparam TArguments The types of the arguments to the method.
+        template <typename TReturn, typename ...TArguments>
+        MethodStatisticsRecorder<true>& getStatisticsRecorder(
+            MethodSlot<TReturn, TArguments...> methodSlot,
+            const char* methodString,
+            std::true_type) {
+            // Serialize the access in concurrent mode.
+            std::unique_lock<std::mutex> lock = lockInConcurrentMode();
+
+            // Get the MockMethod and return its MethodStatisticsRecorder.
+            return getMockMethod(methodSlot, methodString)
+                .getStatisticsRecorder();
+        }
+
+        /// Creates an empty MethodStatisticsRecorder without looking up the
+        /// MockMethod of the method, when statistics are disabled.
+        ///
+        /// @return An empty MethodStatisticsRecorder.
+        /// @tparam TReturn The return type of the method.
+        /// @tparam TArguments The types of the arguments to the method.
+        template <typename TReturn, typename ...TArguments>
+        MethodStatisticsRecorder<false> getStatisticsRecorder(
+            MethodSlot<TReturn, TArguments...>,
+            const char*,
+            std::false_type) {
+            // Return an empty MethodStatisticsRecorder.
+            return MethodStatisticsRecorder<false>();
+        }
+
+        /// Gets the MockMethod of the provided method, creating it and
+        /// inserting its onCall method into the virtual table if the method
+        /// has no mock cases. _addCaseMutex must be locked in concurrent mode.
+        ///
+        /// @param methodSlot The MethodSlot of the method.
+        /// @param methodString A string describing how a call is made to the
+        /// method being mocked.
+        /// @return The MockMethod of the method.
+        /// @throws Throws a MethodMockedAfterCallsException if the MockMethod
+        /// must be created after calls may have started in concurrent mode.
+        /// @tparam TReturn The return type of the method being mocked.
+        /// @tparam TArguments The types of the arguments to the method being
+        /// mocked.
+        template <typename TReturn, typename ...TArguments>
+        MockMethod<TReturn, TArguments...>& getMockMethod(
+            MethodSlot<TReturn, TArguments...> methodSlot,
+            const char* methodString) {
+            // Get the virtual table offset of the method.
+            VirtualTableOffset virtualTableOffset
+                = methodSlot.virtualTableOffset;
+
+            // Get the MockMethod of the method, if any.
+            IMockMethodNonGeneric* mockMethod
+                = getMockMethods()[virtualTableOffset].load(
+                    std::memory_order_relaxed);
+
+            // Check if the method has any existing mock cases.
+            bool methodHasNoMocks = mockMethod == nullptr;
+            if(methodHasNoMocks) {
+                // Refuse to write the virtual table while other threads may
+                // call through it.
+                if(_callsStarted.load(std::memory_order_relaxed)) {
+                    throw Exception::MethodMockedAfterCallsException(
+                        methodString);
+                }
+
+                // Create a MockMethod if the method has no existing mock
+                // cases.
+                mockMethod = _arena.create<
+                    MockMethod<TReturn, TArguments...>>(
+                        methodString,
+                        _concurrency).release();
+
+                // Record calls to the method if the journal is enabled.
+                if(_journalSettings != nullptr) {
+                    mockMethod->enableJournal(*_journalSettings, _arena);
+                }
+
+                // Publish the MockMethod before the virtual table refers to
+                // it.
+                getMockMethods()[virtualTableOffset].store(
+                    mockMethod,
+                    std::memory_order_release);
+
+                // Store a pointer to onCall in the virtual table.
+                _virtualTable.get()[virtualTableOffset]
+                    = union_cast<void*>(methodSlot.onCall);
+            }
+
+            // Cast the MockMethod to its correct type and return it.
+            return static_cast<MockMethod<TReturn, TArguments...>&>(
+                *mockMethod);
+        }
+
     public:
         /// Creates an InnerMock.
-        InnerMock()
-            : _mockFake(_virtualTable.get(), *this) {
+        ///
+        /// @param concurrency Whether the InnerMock may be used by several
+        /// threads at once.
+        /// @param memoryResource The MemoryResource to request memory for the
+        /// mock cases from, which must outlive the InnerMock.
+        InnerMock(
+            Concurrency concurrency = Concurrency::SingleThreaded,
+            MemoryResource& memoryResource
+                = NewDeleteMemoryResource::getInstance())
+            : _arena(memoryResource)
+            , _caseArena(memoryResource)
+            , _mockMethods(nullptr)
+            , _mockFake(_virtualTable.get(), *this)
+            , _concurrency(concurrency)
+            , _callsStarted(false) {
+        }
+
+        /// InnerMock cannot be copied.
+        InnerMock(const InnerMock&) = delete;
+
+        /// InnerMock cannot be copied.
+        InnerMock& operator = (const InnerMock&) = delete;
+
+        /// Destructs the InnerMock by destructing its MockMethod instances,
+        /// after which their memory is released together with _arena.
+        ~InnerMock() noexcept {
+            // Get the MockMethod instances and return if no mock case has been
+            // added.
+            std::atomic<IMockMethodNonGeneric*>* mockMethods
+                = _mockMethods.load(std::memory_order_relaxed);
+            if(mockMethods == nullptr) {
+                return;
+            }
+
+            // Destruct every MockMethod by letting an ArenaPointer take
+            // ownership of it.
+            for(VirtualTableOffset virtualTableOffset = 0;
+                virtualTableOffset < _virtualTable.getSize();
+                virtualTableOffset++) {
+                ArenaPointer<IMockMethodNonGeneric>(
+                    mockMethods[virtualTableOffset].load(
+                        std::memory_order_relaxed));
+            }
         }
 
         /// Gets a reference to an object used in place of an instance of the
         /// interface.
+        ///
+        /// In concurrent mode, no method without mock cases can be mocked
+        /// after this has been called until the InnerMock is reset.
         TInterface& get() {
+            // Stop letting methods be inserted into the virtual table in
+            // concurrent mode since calls may now be made. The flag is only
+            // written once to keep threads from writing the same cache line.
+            if(_concurrency == Concurrency::Concurrent
+                && !_callsStarted.load(std::memory_order_relaxed)) {
+                _callsStarted.store(true, std::memory_order_relaxed);
+            }
+
             // Cast the MockFake to a TInterface and return a reference to it.
-            return reinterpret_cast<TInterface&>(_mockFake);
+            // The cast goes through a void pointer, which only keeps
+            // optimizing compilers from warning about strict aliasing. The
+            // MockFake is accessed through the interface type either way.
+            void* mockFake = &_mockFake;
+            return *static_cast<TInterface*>(mockFake);
+        }
+
+        /// Gets the MethodSlot of a method on the interface.
+        ///
+        /// @return The MethodSlot of the method.
+        /// @tparam TMethod The type of the method.
+        /// @tparam method The method to get the MethodSlot of.
+        /// @tparam TReturn The return type of the method.
+        /// @tparam TArguments The types of the arguments to the method.
+        template <typename TMethod, TMethod method, typename TReturn,
+            typename ...TArguments>
+        static MethodSlot<TReturn, TArguments...> getMethodSlot() {
+            // Create and return a MethodSlot with the virtual table offset of
+            // the method and an onCall method specific to the method.
+            return MethodSlot<TReturn, TArguments...>{
+                VirtualTableOffsetContext::getVirtualTableOffset<
+                    TMethod, method>(),
+                &MockFake::template onCall<TMethod, method, TReturn,
+                    TArguments...>
+            };
+        }
+
+        /// Creates a value, such as a mock case, in the Arena of the
+        /// InnerMock.
+        ///
+        /// @param arguments The arguments used to create the value.
+        /// @return An ArenaPointer owning the value, which must be destroyed
+        /// before the InnerMock.
+        /// @tparam TValue The type of the value to create.
+        /// @tparam TArguments The types of the arguments used to create the
+        /// value.
+        template <typename TValue, typename ...TArguments>
+        ArenaPointer<TValue> create(TArguments&&... arguments) {
+            // Serialize the use of the Arena in concurrent mode.
+            std::unique_lock<std::mutex> lock = lockInConcurrentMode();
+
+            // Create the value in the Arena.
+            return _caseArena.create<TValue>(
+                std::forward<TArguments>(arguments)...);
+        }
+
+        /// Gets the statistics of the provided method, creating its MockMethod
+        /// if the method has no mock cases.
+        ///
+        /// @param methodSlot The MethodSlot of the method.
+        /// @param methodString A string describing how a call is made to the
+        /// method.
+        /// @return A reference to the MethodStatisticsRecorder of the method,
+        /// which lives as long as the InnerMock, if statistics are enabled and
+        /// an empty MethodStatisticsRecorder otherwise.
+        /// @tparam TReturn The return type of the method.
+        /// @tparam TArguments The types of the arguments to the method.
+        template <typename TReturn, typename ...TArguments>
+        typename MethodStatisticsRecorder<statisticsEnabled>::Reference
+            getStatisticsRecorder(
+                MethodSlot<TReturn, TArguments...> methodSlot,
+                const char* methodString) {
+            // Only look up the MockMethod if statistics are enabled.
+            return getStatisticsRecorder(
+                methodSlot,
+                methodString,
+                std::integral_constant<bool, statisticsEnabled>());
         }
 
         /// Adds a mock case to the provided method.
         ///
-        /// @param method The method to add a mock case to.
+        /// @param methodSlot The MethodSlot of the method to add a mock case
+        /// to.
         /// @param methodString A string describing how a call is made to the
         /// method being mocked.
         /// @param mockCase The mock case to add.
         /// @return A CallCount that can be queried about the number of calls
         /// done to the added mock case.
-        /// @tparam id The MockWithID used to identify the mock case to add.
         /// @tparam TReturn The return type of the method being mocked.
         /// @tparam TArguments The types of the arguments to the method being
         /// mocked.
-        template <MockCaseID id, typename TReturn, typename ...TArguments>
+        template <typename TReturn, typename ...TArguments>
         CallCount addCase(
-            Method<TInterface, TReturn, TArguments...> method,
-            std::string methodString,
-            std::unique_ptr<ICase<TReturn, TArguments...>> mockCase) {
-            // Forward the call to addCaseWithOnCall.
-            return addCaseWithOnCall<TReturn, TArguments...>(
-                id,
-                &MockFake::template onCall<id, TReturn, TArguments...>,
-                method,
-                std::move(methodString),
-                std::move(mockCase));
+            MethodSlot<TReturn, TArguments...> methodSlot,
+            const char* methodString,
+            ArenaPointer<ICase<TReturn, TArguments...>> mockCase) {
+            // Serialize the addition in concurrent mode.
+            std::unique_lock<std::mutex> lock = lockInConcurrentMode();
+
+            // Get the MockMethod of the method and add a mock case to it.
+            return getMockMethod(methodSlot, methodString)
+                .addCase(std::move(mockCase));
         }
 
-    private:
-        /// Adds a mock case to the provided method.
+        /// Adds a mock case to the provided method for every entry in a table
+        /// of arguments and return values.
         ///
-        /// @param id The MockCaseID of the addCase method that made the
-        /// internal call.
-        /// @param onCall The onCall method to insert into the virtual table if
-        /// required.
-        /// @param method The method to add a mock case to.
+        /// @param methodSlot The MethodSlot of the method to add the mock
+        /// cases to.
         /// @param methodString A string describing how a call is made to the
         /// method being mocked.
-        /// @param mockCase The mock case to add.
-        /// @return A CallCount that can be queried about the number of calls
-        /// done to the added mock case.
+        /// @param begin An iterator to the first entry.
+        /// @param end An iterator past the last entry.
+        /// @return A CallCounts that can be queried about the number of calls
+        /// done to the added mock cases.
         /// @tparam TReturn The return type of the method being mocked.
         /// @tparam TArguments The types of the arguments to the method being
         /// mocked.
-        template <typename TReturn, typename ...TArguments>
-        CallCount addCaseWithOnCall(
-            MockCaseID id,
-            Method<MockFake, TReturn, TArguments...> onCall,
-            Method<TInterface, TReturn, TArguments...> method,
-            std::string methodString,
-            std::unique_ptr<ICase<TReturn, TArguments...>> mockCase) {
-            // Check if a virtual table offset has been stored in
-            // _virtualTableOffsets for the provided MockCaseID.
-            bool virtualTableOffsetsNoID = _virtualTableOffsets.count(id) == 0;
-            if(virtualTableOffsetsNoID) {
-                // Get the virtual table offset of the method and store it.
-                _virtualTableOffsets[id] = VirtualTableOffsetContext
-                    ::getVirtualTableOffset(method);
-            }
-
-            // Get the virtual table offset of the provided MockCaseID.
-            VirtualTableOffset virtualTableOffset = _virtualTableOffsets[id];
+        /// @tparam TIterator The type of the iterators.
+        template <typename TReturn, typename ...TArguments,
+            typename TIterator>
+        CallCounts addTable(
+            MethodSlot<TReturn, TArguments...> methodSlot,
+            const char* methodString,
+            TIterator begin,
+            TIterator end) {
+            // Serialize the addition in concurrent mode.
+            std::unique_lock<std::mutex> lock = lockInConcurrentMode();
 
-            // Check if the method has any existing mock cases.
-            bool methodHasNoMocks = _mockMethods.count(virtualTableOffset) == 0;
-            if(methodHasNoMocks) {
-                // Create and store a MockMethod if the method has no existing
-                // mock cases.
-                _mockMethods[virtualTableOffset] = makeUnique<
-                    MockMethod<TReturn, TArguments...>>(
-                        std::move(methodString));
+            // Get the MockMethod of the method and add the mock cases to it.
+            return getMockMethod(methodSlot, methodString)
+                .addTable(std::move(begin), std::move(end), _caseArena);
+        }
 
-                // Store a pointer to onCall in the virtual table.
-                _virtualTable.get()[virtualTableOffset]
-                    = union_cast<void*>(onCall);
+        /// Removes every mock case while keeping the MockMethod instances,
+        /// the virtual table and the memory used to store the mock cases,
+        /// which makes adding mock cases again cheap. The journal stays
+        /// enabled if it has been enabled, while its recorded calls are
+        /// removed.
+        ///
+        /// Methods that have been mocked before behave as if they have never
+        /// been mocked. CallCount instances created before stay valid and
+        /// keep their call counts.
+        ///
+        /// This must not be called while calls are being made.
+        void reset() {
+            // Serialize the reset in concurrent mode.
+            std::unique_lock<std::mutex> lock = lockInConcurrentMode();
+
+            // Get the MockMethod instances and reset every one of them, if any
+            // mock case has been added.
+            std::atomic<IMockMethodNonGeneric*>* mockMethods
+                = _mockMethods.load(std::memory_order_relaxed);
+            if(mockMethods != nullptr) {
+                for(VirtualTableOffset virtualTableOffset = 0;
+                    virtualTableOffset < _virtualTable.getSize();
+                    virtualTableOffset++) {
+                    IMockMethodNonGeneric* mockMethod
+                        = mockMethods[virtualTableOffset].load(
+                            std::memory_order_relaxed);
+                    if(mockMethod != nullptr) {
+                        mockMethod->reset();
+                    }
+                }
+            }
+
+            // Reuse the memory of the mock cases, which have been destructed.
+            _caseArena.reset();
+
+            // Let methods be inserted into the virtual table again since no
+            // calls are being made.
+            _callsStarted.store(false, std::memory_order_relaxed);
+
+            // Number the calls from zero again if the journal is enabled.
+            if(_journalSettings != nullptr) {
+                _journalSettings->callCount.store(
+                    0,
+                    std::memory_order_relaxed);
             }
-            
-            // Get the MockMethod for the method and add a mock case to it.
-            return getMockMethod<TReturn, TArguments...>(virtualTableOffset)
-                .addCase(std::move(mockCase));
         }
 
+        /// Starts recording calls in a journal.
+        ///
+        /// @param capacity The number of calls to keep for every method, which
+        /// must be at least one.
+        /// @param sampleInterval Only one in this many calls is recorded,
+        /// which must be at least one.
+        /// @throws Throws an InvalidJournalSettingsException if the capacity or
+        /// the sample interval is zero.
+        /// @throws Throws a JournalEnabledTwiceException if the journal has
+        /// already been enabled.
+        void enableJournal(std::size_t capacity, std::size_t sampleInterval) {
+            // Check that the journal can record calls, since calls divide by
+            // both values.
+            if(capacity == 0 || sampleInterval == 0) {
+                throw Exception::InvalidJournalSettingsException();
+            }
+
+            // Serialize the change in concurrent mode.
+            std::unique_lock<std::mutex> lock = lockInConcurrentMode();
+
+            // Check if the journal already has been enabled.
+            if(_journalSettings != nullptr) {
+                throw Exception::JournalEnabledTwiceException();
+            }
+
+            // Create the settings.
+            _journalSettings.reset(new CallJournalSettings(
+                capacity,
+                sampleInterval,
+                _concurrency));
+
+            // Get the MockMethod instances and return if no mock case has been
+            // added yet.
+            std::atomic<IMockMethodNonGeneric*>* mockMethods
+                = _mockMethods.load(std::memory_order_relaxed);
+            if(mockMethods == nullptr) {
+                return;
+            }
+
+            // Enable the journal of every existing MockMethod.
+            for(VirtualTableOffset virtualTableOffset = 0;
+                virtualTableOffset < _virtualTable.getSize();
+                virtualTableOffset++) {
+                IMockMethodNonGeneric* mockMethod
+                    = mockMethods[virtualTableOffset].load(
+                        std::memory_order_relaxed);
+                if(mockMethod != nullptr) {
+                    mockMethod->enableJournal(*_journalSettings, _arena);
+                }
+            }
+        }
 
-        /// Called when a call to a method in the interface is called.
+        /// Gets the calls recorded in the journal.
         ///
-        /// @param id The MockCaseID of the onCall method that made the internal
-        /// call.
-        /// @param mockFake The MockFake instance this call was made on.
-        /// @param arguments The arguments the method was called with.
-        /// @return The return value from the first matching mock case.
-        /// @throws Throws an UnmockedCallException if the arguments does not
-        /// match any mock case.
-        /// @tparam id The MockWithID used to identify the mock case that first
-        /// added a mock case to the method.
-        /// @tparam TReturn The return type of the mocked method.
-        /// @tparam TArguments The types of the arguments to the mocked method.
-        template <typename TReturn, typename ...TArguments>
-        TReturn onCall(
-            MockCaseID id,
-            TArguments... arguments) {
-            // Get the virtual table offset for the MockCaseID.
-            VirtualTableOffset virtualTableOffset = _virtualTableOffsets[id];
+        /// This must not be called while calls are being made.
+        ///
+        /// @return The recorded calls ordered by their sequence numbers.
+        std::vector<JournalEntry> getJournal() {
+            // Serialize the access in concurrent mode.
+            std::unique_lock<std::mutex> lock = lockInConcurrentMode();
+
+            // Create an empty journal.
+            std::vector<JournalEntry> entries;
+
+            // Get the MockMethod instances and return the empty journal if no
+            // mock case has been added.
+            std::atomic<IMockMethodNonGeneric*>* mockMethods
+                = _mockMethods.load(std::memory_order_relaxed);
+            if(mockMethods == nullptr) {
+                return entries;
+            }
+
+            // Append the recorded calls of every MockMethod.
+            for(VirtualTableOffset virtualTableOffset = 0;
+                virtualTableOffset < _virtualTable.getSize();
+                virtualTableOffset++) {
+                IMockMethodNonGeneric* mockMethod
+                    = mockMethods[virtualTableOffset].load(
+                        std::memory_order_relaxed);
+                if(mockMethod != nullptr) {
+                    mockMethod->appendJournalEntries(entries);
+                }
+            }
 
-            // Get the MockMethod for the called method and forward the call to
-            // onCall.
-            return getMockMethod<TReturn, TArguments...>(virtualTableOffset)
-                .onCall(std::forward<TArguments>(arguments)...);
+            // Order the calls by their sequence numbers.
+            std::sort(
+                entries.begin(),
+                entries.end(),
+                [](const JournalEntry& a, const JournalEntry& b) {
+                    return a.sequenceNumber < b.sequenceNumber;
+                });
+
+            // Return the journal.
+            return entries;
         }
 
-        /// Gets the MockMethod for the method with the provided virtual table
-        /// offset.
+#if defined(IMOCK_STATISTICS)
+        /// Gets statistics describing how calls to the mocked methods have
+        /// been handled.
         ///
-        /// @param virtualTableOffset The method's virtual table offset.
-        /// @return The method's MockMethod.
-        /// @tparam TReturn The return type of the mocked method.
-        /// @tparam TArguments The types of the arguments to the mocked method.
-        template <typename TReturn, typename ...TArguments>
-        MockMethod<TReturn, TArguments...>& getMockMethod(
-            VirtualTableOffset virtualTableOffset) const {
-            // Get the MockMethod from _mockMethods.
-            IMockMethodNonGeneric& mockMethodNonGeneric
-                = *_mockMethods.at(virtualTableOffset).get();
+        /// This must not be called while calls are being made.
+        ///
+        /// @return MethodStatistics for every method with mock cases.
+        std::vector<MethodStatistics> getStatistics() {
+            // Serialize the access in concurrent mode.
+            std::unique_lock<std::mutex> lock = lockInConcurrentMode();
+
+            // Create an empty list of statistics.
+            std::vector<MethodStatistics> statistics;
 
-            // Cast mockMethodNonGeneric to its correct type.
-            MockMethod<TReturn, TArguments...>& mockMethod
-                = reinterpret_cast<MockMethod<TReturn, TArguments...>&>(
-                    mockMethodNonGeneric);
+            // Get the MockMethod instances and return the empty list if no
+            // mock case has been added.
+            std::atomic<IMockMethodNonGeneric*>* mockMethods
+                = _mockMethods.load(std::memory_order_relaxed);
+            if(mockMethods == nullptr) {
+                return statistics;
+            }
+
+            // Append the statistics of every MockMethod.
+            for(VirtualTableOffset virtualTableOffset = 0;
+                virtualTableOffset < _virtualTable.getSize();
+                virtualTableOffset++) {
+                IMockMethodNonGeneric* mockMethod
+                    = mockMethods[virtualTableOffset].load(
+                        std::memory_order_relaxed);
+                if(mockMethod != nullptr) {
+                    mockMethod->appendStatistics(statistics);
+                }
+            }
 
-            // Return the MockMethod.
-            return mockMethod;
+            // Return the statistics.
+            return statistics;
         }
+#endif
 };
 
+IMOCK_STATISTICS_NAMESPACE_END
 }
 }
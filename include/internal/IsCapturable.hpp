@@ -0,0 +1,38 @@
+#pragma once
+
+#include <type_traits>
+
+#include <internal/IsCharacterPointer.hpp>
+
+namespace IMock {
+namespace Internal {
+
+/// Checks if the arguments of a call can be kept after the call has returned,
+/// which requires a value to be created from every argument. Reference
+/// arguments are copied while other arguments are moved.
+///
+/// Pointers to characters are not capturable since the characters they point
+/// to are only read when the arguments are converted to strings, at which
+/// point they may have been freed.
+///
+/// @tparam TArguments The types of the arguments of the call.
+template <typename ...TArguments>
+struct IsCapturable;
+
+//! @cond Doxygen_Suppress
+template <>
+struct IsCapturable<> : std::true_type {
+};
+
+template <typename TArgument, typename ...TArguments>
+struct IsCapturable<TArgument, TArguments...> : std::integral_constant<bool,
+    std::is_constructible<
+        typename std::decay<TArgument>::type,
+        TArgument>::value
+    && !IsCharacterPointer<typename std::decay<TArgument>::type>::value
+    && IsCapturable<TArguments...>::value> {
+};
+//! @endcond
+
+}
+}
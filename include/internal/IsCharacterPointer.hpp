@@ -0,0 +1,30 @@
+#pragma once
+
+#include <type_traits>
+
+namespace IMock {
+namespace Internal {
+
+/// Checks if a type is a pointer to characters, which is converted to a
+/// string by reading the characters it points to.
+///
+/// @tparam TValue The type to check, which must have been decayed.
+template <typename TValue>
+struct IsCharacterPointer : std::false_type {
+};
+
+//! @cond Doxygen_Suppress
+template <typename TCharacter>
+struct IsCharacterPointer<TCharacter*> : std::integral_constant<bool,
+    std::is_same<typename std::remove_cv<TCharacter>::type, char>::value
+    || std::is_same<
+        typename std::remove_cv<TCharacter>::type,
+        signed char>::value
+    || std::is_same<
+        typename std::remove_cv<TCharacter>::type,
+        unsigned char>::value> {
+};
+//! @endcond
+
+}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+
+namespace IMock {
+namespace Internal {
+
+/// An exception message that is created the first time it is needed, which
+/// makes exceptions cheap to throw and catch when the message is never read.
+class LazyMessage {
+    private:
+        /// Makes sure the message is only created once.
+        std::once_flag _createdFlag;
+
+        /// The message, which is empty until it has been created.
+        std::string _message;
+
+    protected:
+        /// Creates the message.
+        ///
+        /// @return The message.
+        virtual std::string createMessage() = 0;
+
+    public:
+        /// Virtual destructor of LazyMessage.
+        virtual ~LazyMessage() noexcept {
+        }
+
+        /// Gets the message and creates it if it has not been created yet.
+        ///
+        /// @return A reference to the message, which is empty if it could not
+        /// be created.
+        const std::string& get() noexcept {
+            // Create the message once, even if several threads ask for it.
+            std::call_once(_createdFlag, [this]() {
+                try {
+                    _message = createMessage();
+                }
+                catch(...) {
+                    // Leave the message empty since what() must not throw.
+                }
+            });
+
+            // Return the message.
+            return _message;
+        }
+};
+
+}
+}
@@ -0,0 +1,314 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <internal/StatisticsNamespace.hpp>
+#include <Concurrency.hpp>
+#include <MethodStatistics.hpp>
+
+namespace IMock {
+namespace Internal {
+
+/// Whether MethodStatistics are collected, which is decided by defining
+/// IMOCK_STATISTICS before IMock is included. It must be defined in the same
+/// way wherever IMock is included, which is checked when linking since the
+/// types depending on it are placed in IMOCK_STATISTICS_NAMESPACE_BEGIN.
+#if defined(IMOCK_STATISTICS)
+static const bool statisticsEnabled = true;
+#else
+static const bool statisticsEnabled = false;
+#endif
+
+IMOCK_STATISTICS_NAMESPACE_BEGIN
+
+/// Counts how calls to a mocked method are handled.
+///
+/// @tparam enabled Whether the calls are counted. If they aren't, every
+/// method does nothing, which lets calls compile as if the recorder did not
+/// exist.
+template <bool enabled>
+class MethodStatisticsRecorder;
+
+/// A MethodStatisticsRecorder counting calls.
+///
+/// The counters are atomic, which lets several threads make calls at once,
+/// while they must only be read when no calls are being made.
+template <>
+class MethodStatisticsRecorder<true> {
+    private:
+        /// The number of buckets in the histograms, which covers every number
+        /// of mock cases a MockMethod can hold on 32 bit platforms and calls to
+        /// fakes taking up to about four seconds.
+        static const std::size_t bucketCount = 32;
+
+        /// Whether calls may be made by several threads at once.
+        Concurrency _concurrency;
+
+        /// The number of calls.
+        std::atomic<std::uint64_t> _callCount;
+
+        /// The number of calls handled without searching the mock cases.
+        std::atomic<std::uint64_t> _hitCount;
+
+        /// The number of calls for which the mock cases were searched.
+        std::atomic<std::uint64_t> _missCount;
+
+        /// The number of calls that did not match any mock case.
+        std::atomic<std::uint64_t> _unmatchedCallCount;
+
+        /// The number of matched calls per power of two of the number of mock
+        /// cases checked.
+        std::atomic<std::uint64_t> _scannedMockCaseHistogram[bucketCount];
+
+        /// The number of calls to fakes per power of two of the number of
+        /// nanoseconds they took.
+        std::atomic<std::uint64_t> _fakeLatencyHistogram[bucketCount];
+
+        /// Increases a counter by one.
+        ///
+        /// @param counter The counter to increase.
+        void increase(std::atomic<std::uint64_t>& counter) {
+            // Use an atomic read-modify-write operation only if several
+            // threads may make calls at once.
+            if(_concurrency == Concurrency::Concurrent) {
+                counter.fetch_add(1, std::memory_order_relaxed);
+            }
+            else {
+                counter.store(
+                    counter.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+            }
+        }
+
+        /// Increases the bucket of a histogram containing a value, which is
+        /// the base two logarithm of the value rounded down.
+        ///
+        /// @param histogram The histogram.
+        /// @param value The value.
+        void increaseBucket(
+            std::atomic<std::uint64_t> (&histogram)[bucketCount],
+            std::uint64_t value) {
+            // Get the bucket of the value.
+            std::size_t bucket = 0;
+            while(value >>= 1) {
+                bucket++;
+            }
+            if(bucket >= bucketCount) {
+                bucket = bucketCount - 1;
+            }
+
+            // Increase the number of values in the bucket.
+            increase(histogram[bucket]);
+        }
+
+        /// Copies a histogram up to its last non-zero bucket.
+        ///
+        /// @param histogram The histogram.
+        /// @return The copy.
+        static std::vector<std::uint64_t> copyHistogram(
+            const std::atomic<std::uint64_t> (&histogram)[bucketCount]) {
+            // Find the last non-zero bucket.
+            std::size_t usedBucketCount = bucketCount;
+            while(usedBucketCount > 0
+                && histogram[usedBucketCount - 1].load(
+                    std::memory_order_relaxed) == 0) {
+                usedBucketCount--;
+            }
+
+            // Copy the buckets up to it.
+            std::vector<std::uint64_t> copy;
+            copy.reserve(usedBucketCount);
+            for(std::size_t bucket = 0; bucket < usedBucketCount; bucket++) {
+                copy.push_back(histogram[bucket].load(
+                    std::memory_order_relaxed));
+            }
+            return copy;
+        }
+
+    public:
+        /// How fakes refer to the MethodStatisticsRecorder of their method.
+        typedef MethodStatisticsRecorder& Reference;
+
+        /// Measures a call to a fake from its creation until its destruction,
+        /// which also measures calls that throw.
+        class FakeTimer {
+            private:
+                /// The MethodStatisticsRecorder to record the call in.
+                MethodStatisticsRecorder& _statistics;
+
+                /// The time the call started.
+                std::chrono::steady_clock::time_point _start;
+
+            public:
+                /// Starts measuring a call to a fake.
+                ///
+                /// @param statistics The MethodStatisticsRecorder to record
+                /// the call in.
+                FakeTimer(MethodStatisticsRecorder& statistics)
+                    : _statistics(statistics)
+                    , _start(std::chrono::steady_clock::now()) {
+                }
+
+                /// FakeTimer cannot be copied.
+                FakeTimer(const FakeTimer&) = delete;
+
+                /// FakeTimer cannot be copied.
+                FakeTimer& operator = (const FakeTimer&) = delete;
+
+                /// Records the time taken by the call.
+                ~FakeTimer() noexcept {
+                    // Record the elapsed time in nanoseconds.
+                    _statistics.onFakeCall(static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - _start)
+                                .count()));
+                }
+        };
+
+        /// Creates a MethodStatisticsRecorder without any counted calls.
+        ///
+        /// @param concurrency Whether calls may be made by several threads at
+        /// once.
+        MethodStatisticsRecorder(Concurrency concurrency)
+            : _concurrency(concurrency) {
+            // Set every counter to zero.
+            reset();
+        }
+
+        /// Counts a call.
+        void onCall() {
+            // Increase the number of calls.
+            increase(_callCount);
+        }
+
+        /// Counts a call handled without searching the mock cases.
+        void onHit() {
+            // Increase the number of hits.
+            increase(_hitCount);
+        }
+
+        /// Counts a call for which the mock cases are searched.
+        void onMiss() {
+            // Increase the number of misses.
+            increase(_missCount);
+        }
+
+        /// Counts a call that matched a mock case.
+        ///
+        /// @param scannedMockCaseCount The number of mock cases checked before
+        /// the match was made, including the matching one.
+        void onMatch(std::size_t scannedMockCaseCount) {
+            // Increase the number of calls in the bucket of the number of mock
+            // cases.
+            increaseBucket(_scannedMockCaseHistogram, scannedMockCaseCount);
+        }
+
+        /// Counts a call to a fake.
+        ///
+        /// @param nanoseconds The time taken by the call.
+        void onFakeCall(std::uint64_t nanoseconds) {
+            // Increase the number of calls in the bucket of the time taken.
+            increaseBucket(_fakeLatencyHistogram, nanoseconds);
+        }
+
+        /// Counts a call that did not match any mock case.
+        void onUnmatchedCall() {
+            // Increase the number of unmatched calls.
+            increase(_unmatchedCallCount);
+        }
+
+        /// Sets every counter to zero.
+        ///
+        /// This must not be called while calls are being made.
+        void reset() {
+            // Reset the counters.
+            _callCount.store(0, std::memory_order_relaxed);
+            _hitCount.store(0, std::memory_order_relaxed);
+            _missCount.store(0, std::memory_order_relaxed);
+            _unmatchedCallCount.store(0, std::memory_order_relaxed);
+            for(std::size_t bucket = 0; bucket < bucketCount; bucket++) {
+                _scannedMockCaseHistogram[bucket].store(
+                    0,
+                    std::memory_order_relaxed);
+                _fakeLatencyHistogram[bucket].store(
+                    0,
+                    std::memory_order_relaxed);
+            }
+        }
+
+        /// Appends MethodStatistics with the counted calls.
+        ///
+        /// @param methodString A string describing how a call is made to the
+        /// mocked method.
+        /// @param statistics The vector to append the MethodStatistics to.
+        void appendStatistics(
+            const std::string& methodString,
+            std::vector<MethodStatistics>& statistics) const {
+            // Copy the counters and the histograms and append them.
+            statistics.push_back(MethodStatistics{
+                methodString,
+                _callCount.load(std::memory_order_relaxed),
+                _hitCount.load(std::memory_order_relaxed),
+                _missCount.load(std::memory_order_relaxed),
+                _unmatchedCallCount.load(std::memory_order_relaxed),
+                copyHistogram(_scannedMockCaseHistogram),
+                copyHistogram(_fakeLatencyHistogram)
+            });
+        }
+};
+
+//! @cond Doxygen_Suppress
+template <>
+class MethodStatisticsRecorder<false> {
+    public:
+        typedef MethodStatisticsRecorder Reference;
+
+        class FakeTimer {
+            public:
+                FakeTimer(MethodStatisticsRecorder&) {
+                }
+        };
+
+        MethodStatisticsRecorder() {
+        }
+
+        MethodStatisticsRecorder(Concurrency) {
+        }
+
+        void onCall() {
+        }
+
+        void onHit() {
+        }
+
+        void onMiss() {
+        }
+
+        void onMatch(std::size_t) {
+        }
+
+        void onFakeCall(std::uint64_t) {
+        }
+
+        void onUnmatchedCall() {
+        }
+
+        void reset() {
+        }
+
+        void appendStatistics(
+            const std::string&,
+            std::vector<MethodStatistics>&) const {
+        }
+};
+//! @endcond
+
+IMOCK_STATISTICS_NAMESPACE_END
+}
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <exception/MockWithArgumentsUsedTwiceException.hpp>
+#include <internal/AreConvertible.hpp>
+#include <internal/Arena.hpp>
+#include <internal/ICase.hpp>
+#include <internal/InnerMock.hpp>
+#include <internal/IReturnValue.hpp>
+#include <internal/StatisticsNamespace.hpp>
+#include <CallCount.hpp>
+
+namespace IMock {
+namespace Internal {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
+
+/// Adds a mock case for a method once its return value has been provided.
+/// Subclasses decide which calls the mock case matches.
+///
+/// @tparam TInterface The interface that the mocked method belongs to.
+/// @tparam TReturn The return type of the method.
+/// @tparam TArguments The types of the arguments to the method.
+template <typename TInterface, typename TReturn, typename ...TArguments>
+class MockCaseBuilder {
+    private:
+        /// The InnerMock to add a mock case to.
+        InnerMock<TInterface>& _mock;
+
+        /// The MethodSlot of the method to add a mock case to.
+        typename InnerMock<TInterface>::template MethodSlot<
+            TReturn, TArguments...> _methodSlot;
+
+        /// A string describing how a call is made to the method being mocked,
+        /// which is a string literal created by when.
+        const char* _methodString;
+
+        /// Describes if the instance already has been used.
+        bool _used;
+
+    protected:
+        /// Creates a MockCaseBuilder.
+        ///
+        /// @param mock The InnerMock to add a mock case to.
+        /// @param methodSlot The MethodSlot of the method to add a mock case
+        /// to.
+        /// @param methodString A string describing how a call is made to the
+        /// method being mocked.
+        MockCaseBuilder(
+            InnerMock<TInterface>& mock,
+            typename InnerMock<TInterface>::template MethodSlot<
+                TReturn, TArguments...> methodSlot,
+            const char* methodString)
+            : _mock(mock)
+            , _methodSlot(std::move(methodSlot))
+            , _methodString(methodString)
+            , _used(false) {
+        }
+
+        /// Gets the InnerMock to add a mock case to.
+        ///
+        /// @return The InnerMock.
+        InnerMock<TInterface>& getMock() {
+            // Return the InnerMock.
+            return _mock;
+        }
+
+        /// Creates the mock case to add, which may move values out of the
+        /// MockCaseBuilder as it is only called once.
+        ///
+        /// @param returnValue The return value to use when a match happens.
+        /// @return The created mock case.
+        virtual ArenaPointer<ICase<TReturn, TArguments...>> createCase(
+            ArenaPointer<IReturnValue<TReturn, TArguments...>> returnValue)
+            = 0;
+
+    public:
+        /// Virtual destructor of MockCaseBuilder.
+        virtual ~MockCaseBuilder() noexcept {
+        }
+
+        // The solution for dealing with void has been taken from:
+        // https://eli.thegreenplace.net/2014/sfinae-and-enable_if/
+
+        /// Adds a mock case making the associated method return the provided
+        /// value when called with the associated arguments.
+        ///
+        /// The method is available unless the return type is void.
+        ///
+        /// @param returnValue The value to return when a match happens.
+        /// @return A CallCount that can be queried about the number of calls
+        /// done to the added mock case.
+        /// @tparam R The return type of the method as infered from TReturn.
+        /// Do not override it.
+        template<typename R = TReturn>
+        CallCount returns(
+            typename std::enable_if<!std::is_void<R>::value, TReturn>::type
+                returnValue) {
+            // Forward a NonVoidReturnValue with the return value to
+            // addCaseWithReturnValue.
+            return addCaseWithReturnValue(_mock.template create<
+                NonVoidReturnValue<TReturn, TArguments...>>(
+                    std::forward<TReturn>(returnValue)));
+        }
+
+        /// Adds a mock case making the associated method return the provided
+        /// values in order when called with the associated arguments, one
+        /// value per call.
+        ///
+        /// Once every value has been returned, the last value is returned
+        /// for every following call. Values without copy constructors are
+        /// instead returned once each, after which a
+        /// ReturnValuesExhaustedException is thrown. Values that claim to
+        /// have copy constructors without being copyable, such as vectors of
+        /// unique pointers, must be passed to returnsOnce() instead.
+        ///
+        /// The method is available unless the return type is void.
+        ///
+        /// @param firstReturnValue The value to return for the first call.
+        /// @param secondReturnValue The value to return for the second call.
+        /// @param returnValues The values to return for the following calls.
+        /// @return A CallCount that can be queried about the number of calls
+        /// done to the added mock case.
+        /// @tparam R The return type of the method as infered from TReturn.
+        /// Do not override it.
+        /// @tparam TReturnValues The types of the values to return for the
+        /// following calls, which must be implicitly convertible to TReturn.
+        template<typename R = TReturn, typename ...TReturnValues>
+        typename std::enable_if<
+            AreConvertible<TReturn, TReturnValues...>::value,
+            CallCount>::type returns(
+            typename std::enable_if<!std::is_void<R>::value, TReturn>::type
+                firstReturnValue,
+            typename std::enable_if<!std::is_void<R>::value, TReturn>::type
+                secondReturnValue,
+            TReturnValues&&... returnValues) {
+            // Add a mock case returning the values in order, repeating the
+            // last value if it can be copied.
+            return addSequenceCase<std::is_lvalue_reference<TReturn>::value
+                || std::is_copy_constructible<TReturn>::value>(
+                    std::forward<TReturn>(firstReturnValue),
+                    std::forward<TReturn>(secondReturnValue),
+                    std::forward<TReturnValues>(returnValues)...);
+        }
+
+        /// Adds a mock case making the associated method return the provided
+        /// values in order when called with the associated arguments, one
+        /// value per call.
+        ///
+        /// Every value is moved out and returned once, after which a
+        /// ReturnValuesExhaustedException is thrown. Unlike returns(), this
+        /// never copies a value, which supports values claiming to be
+        /// copyable without being so, such as vectors of unique pointers.
+        ///
+        /// The method is available unless the return type is void.
+        ///
+        /// @param firstReturnValue The value to return for the first call.
+        /// @param returnValues The values to return for the following calls.
+        /// @return A CallCount that can be queried about the number of calls
+        /// done to the added mock case.
+        /// @tparam R The return type of the method as infered from TReturn.
+        /// Do not override it.
+        /// @tparam TReturnValues The types of the values to return for the
+        /// following calls, which must be implicitly convertible to TReturn.
+        template<typename R = TReturn, typename ...TReturnValues>
+        typename std::enable_if<
+            AreConvertible<TReturn, TReturnValues...>::value,
+            CallCount>::type returnsOnce(
+            typename std::enable_if<!std::is_void<R>::value, TReturn>::type
+                firstReturnValue,
+            TReturnValues&&... returnValues) {
+            // Add a mock case moving out every value once.
+            return addSequenceCase<false>(
+                std::forward<TReturn>(firstReturnValue),
+                std::forward<TReturnValues>(returnValues)...);
+        }
+
+        /// Adds a mock case making the associated method callable when called
+        /// with the associated arguments.
+        ///
+        /// The method is only available if the return type is void.
+        ///
+        /// @return A CallCount that can be queried about the number of calls
+        /// done to the added mock case.
+        /// @tparam R The return type of the method as infered from TReturn.
+        /// Do not override it.
+        template<typename R = TReturn,
+            typename std::enable_if<std::is_void<R>::value, R>::type* = nullptr>
+        CallCount returns() {
+            // Forward a VoidReturnValue to addCaseWithReturnValue.
+            return addCaseWithReturnValue(_mock.template create<
+                VoidReturnValue<TArguments...>>());
+        }
+
+        /// Adds a fake handling the method call when called with the associated
+        /// arguments.
+        ///
+        /// @param fake A callable to call when the method is called and a
+        /// match happens, which is stored with its own type.
+        /// @return A CallCount that can be queried about the number of calls
+        /// done to the added mock case.
+        /// @tparam TFake The type of the callable.
+        template <typename TFake>
+        CallCount fake(TFake fake) {
+            // Forward a FakeReturnValue with the fake and the statistics of
+            // the method, which are empty unless enabled, to
+            // addCaseWithReturnValue.
+            return addCaseWithReturnValue(_mock.template create<
+                FakeReturnValue<TFake, TReturn, TArguments...>>(
+                    std::move(fake),
+                    _mock.template getStatisticsRecorder<
+                        TReturn, TArguments...>(_methodSlot, _methodString)));
+        }
+
+    private:
+        /// Implicitly converts a value passed to returns() to the return type.
+        ///
+        /// @param returnValue The converted value.
+        /// @return The converted value.
+        /// @tparam R The return type of the method, which is passed
+        /// explicitly to keep the method from being declared for void.
+        template <typename R>
+        static R toReturnValue(R returnValue) {
+            // Return the converted value.
+            return std::forward<R>(returnValue);
+        }
+
+        /// Adds a mock case making the associated method return the provided
+        /// values in order when called with the associated arguments.
+        ///
+        /// @param returnValues The values to return, one per call.
+        /// @return A CallCount that can be queried about the number of calls
+        /// done to the added mock case.
+        /// @tparam repeatLast Whether the last value is returned forever
+        /// instead of once.
+        /// @tparam TReturnValues The types of the values to return, which
+        /// must be implicitly convertible to TReturn.
+        template <bool repeatLast, typename ...TReturnValues>
+        CallCount addSequenceCase(TReturnValues&&... returnValues) {
+            // Store the values contiguously in the order they are returned.
+            std::vector<typename SequenceReturnValue<
+                repeatLast, TReturn, TArguments...>::StoredValue> storedValues;
+            storedValues.reserve(sizeof...(TReturnValues));
+            int expand[] = {
+                0,
+                (storedValues.emplace_back(toReturnValue<TReturn>(
+                    std::forward<TReturnValues>(returnValues))), 0)...
+            };
+            (void) expand;
+
+            // Forward a SequenceReturnValue with the values to
+            // addCaseWithReturnValue.
+            return addCaseWithReturnValue(_mock.template create<
+                SequenceReturnValue<repeatLast, TReturn, TArguments...>>(
+                    std::move(storedValues)));
+        }
+
+        /// Adds a mock case making calls to the associated method use the
+        /// provided return value when called with the associated arguments.
+        ///
+        /// @param returnValue The return value to use when a match happens.
+        /// @return A CallCount that can be queried about the number of calls
+        /// done to the added mock case.
+        CallCount addCaseWithReturnValue(
+            ArenaPointer<IReturnValue<TReturn, TArguments...>> returnValue) {
+            // Check if the instance already has been used.
+            if(_used) {
+                // Throw a MockWithArgumentsUsedTwiceException since the
+                // instance cannot be used again as the arguments has been
+                // moved.
+                throw Exception::MockWithArgumentsUsedTwiceException();
+            }
+            else {
+                // Raise the _used flag to mark that the instance has been used.
+                _used = true;
+            }
+
+            // Create the mock case, which moves the arguments and means the
+            // instance cannot be used again.
+            ArenaPointer<ICase<TReturn, TArguments...>> mockCase
+                = createCase(std::move(returnValue));
+
+            // Add the case to InnerMock.
+            return _mock.template addCase<TReturn, TArguments...>(
+                _methodSlot,
+                _methodString,
+                std::move(mockCase));
+        }
+};
+
+IMOCK_STATISTICS_NAMESPACE_END
+}
+}
@@ -1,88 +1,246 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <atomic>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <exception/UnknownCallException.hpp>
 #include <exception/UnmockedCallException.hpp>
-#include <internal/Apply.hpp>
+#include <internal/Arena.hpp>
+#include <internal/ArgumentsIndex.hpp>
+#include <internal/CallJournal.hpp>
+#include <internal/CallString.hpp>
 #include <internal/CaseMatch.hpp>
+#include <internal/CaseMatchFactory.hpp>
 #include <internal/ICase.hpp>
 #include <internal/IMockMethodNonGeneric.hpp>
-#include <internal/JoinStrings.hpp>
+#include <internal/IsCapturable.hpp>
+#include <internal/MethodStatisticsRecorder.hpp>
 #include <internal/MutableCallCount.hpp>
-#include <internal/makeUnique.hpp>
-#include <internal/ToString.hpp>
+#include <internal/SegmentedVector.hpp>
+#include <internal/StatisticsNamespace.hpp>
+#include <internal/TableCase.hpp>
 #include <CallCount.hpp>
+#include <CallCounts.hpp>
+#include <Concurrency.hpp>
+#include <JournalEntry.hpp>
+#include <MethodStatistics.hpp>
 
 namespace IMock {
 namespace Internal {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
 
 /// A mocked method containing a number of mock cases.
 ///
+/// Calls may be made by any number of threads while one thread at a time adds
+/// mock cases. Calls never lock since the mock cases are published through
+/// SegmentedVector and ArgumentsIndex.
+///
 /// @tparam TReturn The return type of the mocked method.
 /// @tparam TArguments The types of the arguments of the mocked method.
 template <typename TReturn, typename ...TArguments>
 class MockMethod : public IMockMethodNonGeneric {
     private:
-        /// Contains information about one mock case.
-        class InnerMockCase {
-            public:
-                /// The mock case's ICase.
-                std::unique_ptr<ICase<TReturn, TArguments...>> _mockCase;
-
-                /// A MutableCallCount keeping track of how many times the mock
-                /// case has been called.
-                std::shared_ptr<MutableCallCount> _callCount;
-
-                /// The next mock case.
-                std::unique_ptr<InnerMockCase> _next;
-
-                /// Creates a InnerMockCase.
-                ///
-                /// @param mockCase The mock case's ICase.
-                /// @param callCount A MutableCallCount keeping track of how
-                /// many times the mock case has been called.
-                /// @param next The next mock case.
-                InnerMockCase(
-                    std::unique_ptr<ICase<TReturn, TArguments...>> mockCase,
-                    std::shared_ptr<MutableCallCount> callCount,
-                    std::unique_ptr<InnerMockCase> next)
-                    : _mockCase(std::move(mockCase))
-                    , _callCount(std::move(callCount))
-                    , _next(std::move(next)) {
-                }
+        /// Checks if any of the argument types is a reference.
+        ///
+        /// @tparam TTypes The types to check.
+        template <typename ...TTypes>
+        struct HasReference : std::integral_constant<bool, !std::is_same<
+            std::tuple<TTypes...>,
+            std::tuple<typename std::remove_reference<TTypes>::type...>>
+                ::value> {
+        };
+
+        /// Refers to a mock case that could not be indexed.
+        struct UnindexedMockCase {
+            /// The mock case, which is owned by _mockCases.
+            ICase<TReturn, TArguments...>* mockCase;
+
+            /// The index of the mock case in _mockCases.
+            std::size_t index;
         };
 
-        /// The most recently mock case to have been added.
-        std::unique_ptr<InnerMockCase> _topMockCase;
+        /// The mock cases in the order they were added. The index of a mock
+        /// case is the number of mock cases added before it, which means a
+        /// mock case with a higher index has precedence.
+        SegmentedVector<ArenaPointer<ICase<TReturn, TArguments...>>>
+            _mockCases;
+
+        /// MutableCallCount instances keeping track of how many times the
+        /// mock cases have been called, stored at the same indices as the mock
+        /// cases. The storage is shared with the CallCount instances referring
+        /// to it to keep it alive for as long as any of them exist.
+        std::shared_ptr<SegmentedVector<MutableCallCount>> _callCounts;
+
+        /// Maps the arguments of mock cases requiring specific arguments to
+        /// the index of the most recently added such mock case, making it
+        /// possible to find them without scanning every mock case. Methods
+        /// without arguments have no index since their mock cases match every
+        /// call.
+        ArgumentsIndex<
+            std::size_t,
+            IsIndexable<TArguments...>::value && sizeof...(TArguments) != 0,
+            TArguments...> _argumentsIndex;
+
+        /// The mock cases that could not be added to _argumentsIndex in the
+        /// order they were added.
+        SegmentedVector<UnindexedMockCase> _unindexedMockCases;
+
+        /// The index plus one of the most recently added mock case if it
+        /// matches every call, such as a fake added without with() or any
+        /// mock case of a method without arguments, and zero otherwise. Calls
+        /// use such a mock case directly since no other mock case can take
+        /// precedence over it.
+        std::atomic<std::size_t> _catchAllMockCase;
+
+        /// The index plus one of the most recently added mock case that does
+        /// not require specific arguments, such as a mock case with matchers
+        /// or a fake, and zero if there is none. Such a mock case may give
+        /// different results for the same arguments, which keeps older mock
+        /// cases from being stored as the last hit.
+        std::atomic<std::size_t> _inexactMockCaseEnd;
+
+        /// The number of mock cases that have been completely added, which is
+        /// increased once a mock case can be found by calls.
+        std::atomic<std::size_t> _addedMockCaseCount;
 
-        /// A string describing how a call is made to the method being mocked.
-        std::string _methodString;
+        /// The mock case that handled the most recent call it can handle
+        /// without checking other mock cases, stored as the number of mock
+        /// cases at the time shifted 32 bits to the left combined with the
+        /// index of the mock case, or zero if no such mock case has been
+        /// stored. Calls check it first, which makes repeated calls with the
+        /// same arguments take a single comparison.
+        std::atomic<std::uint64_t> _lastHit;
+
+        /// A string describing how a call is made to the method being mocked,
+        /// which is shared with the UnmockedCallException instances thrown.
+        std::shared_ptr<const std::string> _methodString;
+
+        /// Whether calls may be made by several threads at once.
+        Concurrency _concurrency;
+
+        /// The journal recording calls to the method, which is stored in the
+        /// Arena of the mock, or nullptr if calls are not recorded.
+        std::atomic<CallJournal<TArguments...>*> _journal;
+
+        /// Counts how calls are handled if IMOCK_STATISTICS is defined and
+        /// does nothing otherwise.
+        MethodStatisticsRecorder<statisticsEnabled> _statistics;
 
     public:
         /// Creates a MockMethod without any mock cases.
         ///
         /// @param methodString A string describing how a call is made to the
         /// method being mocked.
-        MockMethod(std::string methodString)
-            : _topMockCase(std::unique_ptr<InnerMockCase>(nullptr))
-            , _methodString(std::move(methodString)) {
+        /// @param concurrency Whether calls may be made by several threads at
+        /// once.
+        MockMethod(std::string methodString, Concurrency concurrency)
+            : _callCounts(std::make_shared<SegmentedVector<MutableCallCount>>())
+            , _catchAllMockCase(0)
+            , _inexactMockCaseEnd(0)
+            , _addedMockCaseCount(0)
+            , _lastHit(0)
+            , _methodString(std::make_shared<const std::string>(
+                std::move(methodString)))
+            , _concurrency(concurrency)
+            , _journal(nullptr)
+            , _statistics(concurrency) {
         }
 
-        /// Destructs the MockMethod by deleting all InnerMockCase instances
-        /// iteratively to not cause any stack overflows.
+        /// Destructs the MockMethod and its journal, if any.
         ~MockMethod() noexcept {
-            // Declare a pointer for mock cases and initialize it with the top
-            // mock case while releasing its unique_ptr.
-            InnerMockCase* mockCase = _topMockCase.release();
+            // Destruct the journal by letting an ArenaPointer take ownership
+            // of it.
+            ArenaPointer<CallJournal<TArguments...>>(
+                _journal.load(std::memory_order_relaxed));
+        }
+
+        /// Starts recording calls to the method in a journal.
+        ///
+        /// @param settings The settings of the journal, which must outlive
+        /// the MockMethod.
+        /// @param arena The Arena to create the journal in.
+        void enableJournal(
+            CallJournalSettings& settings,
+            Arena& arena) override {
+            // Create the journal and publish it to the calling threads.
+            _journal.store(
+                arena.create<CallJournal<TArguments...>>(settings).release(),
+                std::memory_order_release);
+        }
+
+        /// Removes every mock case and recorded call while keeping the memory
+        /// used to store them.
+        ///
+        /// This must not be called while calls are being made.
+        void reset() override {
+            // Keep the call counts of the mock cases if any CallCount refers
+            // to them by giving the MockMethod new storage for call counts.
+            // Otherwise, reuse the storage.
+            if(_callCounts.use_count() != 1) {
+                _callCounts
+                    = std::make_shared<SegmentedVector<MutableCallCount>>();
+            }
+            else {
+                _callCounts->clear();
+            }
+
+            // Remove the mock cases, which destructs them, and every
+            // reference to them.
+            _mockCases.clear();
+            _argumentsIndex.clear();
+            _unindexedMockCases.clear();
+            _catchAllMockCase.store(0, std::memory_order_relaxed);
+            _inexactMockCaseEnd.store(0, std::memory_order_relaxed);
+            _addedMockCaseCount.store(0, std::memory_order_relaxed);
+            _lastHit.store(0, std::memory_order_relaxed);
 
-            // Iterate while mock cases exist.
-            while(mockCase != nullptr) {
-                // Get the next mock case while releasing its unique_ptr.
-                InnerMockCase* nextMockCase = mockCase->_next.release();
+            // Remove the recorded calls if the journal is enabled.
+            CallJournal<TArguments...>* journal
+                = _journal.load(std::memory_order_relaxed);
+            if(journal != nullptr) {
+                journal->clear();
+            }
 
-                // Delete the mock case.
-                delete mockCase;
+            // Reset the statistics.
+            _statistics.reset();
+        }
 
-                // Assign the next mock case to mockCase to continue with it.
-                mockCase = nextMockCase;
+        /// Gets the statistics of the method, which are used by fakes to
+        /// record the time their calls take.
+        ///
+        /// @return The MethodStatisticsRecorder of the method.
+        MethodStatisticsRecorder<statisticsEnabled>& getStatisticsRecorder() {
+            // Return the MethodStatisticsRecorder.
+            return _statistics;
+        }
+
+        /// Appends MethodStatistics describing how calls to the method have
+        /// been handled, unless statistics are disabled.
+        ///
+        /// @param statistics The vector to append the MethodStatistics to.
+        void appendStatistics(
+            std::vector<MethodStatistics>& statistics) const override {
+            // Let the recorder append the statistics.
+            _statistics.appendStatistics(*_methodString, statistics);
+        }
+
+        /// Appends a JournalEntry for every recorded call to the method.
+        ///
+        /// @param entries The vector to append the entries to.
+        void appendJournalEntries(
+            std::vector<JournalEntry>& entries) const override {
+            // Get the journal and append its entries if there is one.
+            CallJournal<TArguments...>* journal
+                = _journal.load(std::memory_order_acquire);
+            if(journal != nullptr) {
+                journal->appendEntries(*_methodString, entries);
             }
         }
 
@@ -90,100 +248,428 @@ class MockMethod : public IMockMethodNonGeneric {
         ///
         /// @param mockCase A mock case to add.
         CallCount addCase(
-            std::unique_ptr<ICase<TReturn, TArguments...>> mockCase) {
-            // Create a MutableCallCount for the mock case.
-            std::shared_ptr<MutableCallCount> callCountPointer
-                = std::make_shared<MutableCallCount>();
+            ArenaPointer<ICase<TReturn, TArguments...>> mockCase) {
+            // Store the mock case.
+            std::size_t mockCaseIndex = storeCase(std::move(mockCase));
+
+            // Publish the mock case as completely added, which invalidates
+            // the last hit.
+            _addedMockCaseCount.store(
+                mockCaseIndex + 1,
+                std::memory_order_release);
+
+            // Create and return a CallCount for the mock case sharing the
+            // ownership of _callCounts.
+            return CallCount(std::shared_ptr<MutableCallCount>(
+                _callCounts,
+                &(*_callCounts)[mockCaseIndex]));
+        }
+
+        /// Adds a mock case for every entry in a table, making calls with the
+        /// arguments of an entry return its value. Later entries take
+        /// precedence over earlier ones, as if they had been added one by one.
+        ///
+        /// Room is made in the index for every entry at once when the number
+        /// of entries can be found without consuming the range. Calls can
+        /// find every mock case as soon as it has been stored, while they only
+        /// start remembering the new mock cases as their last hit once every
+        /// entry has been added.
+        ///
+        /// @param begin An iterator to the first entry.
+        /// @param end An iterator past the last entry.
+        /// @param arena The Arena to create the mock cases in.
+        /// @return A CallCounts giving access to the call counts of the added
+        /// mock cases in the order of the entries.
+        /// @tparam TIterator The type of the iterators, whose entries have
+        /// the arguments as first and the value to return as second.
+        template <typename TIterator>
+        CallCounts addTable(TIterator begin, TIterator end, Arena& arena) {
+            // Get the index of the first new mock case.
+            std::size_t firstMockCaseIndex = _mockCases.size();
 
-            // Create a InnerMockCase and assign it to _topMockCase.
-            _topMockCase = Internal::makeUnique<InnerMockCase>(
-                std::move(mockCase),
-                callCountPointer,
-                std::move(_topMockCase));
+            // Make room in the index for the entries.
+            reserveTable(
+                begin,
+                end,
+                typename std::iterator_traits<TIterator>::iterator_category());
+
+            // Store a mock case for every entry, which makes it visible to
+            // calls searching the mock cases.
+            for(; begin != end; ++begin) {
+                storeCase(arena.create<TableCase<TReturn, TArguments...>>(
+                    (*begin).first,
+                    (*begin).second));
+            }
 
-            // Create a CallCount for the mock case.
-            CallCount callCount(callCountPointer);
+            // Mark every mock case as completely added at once, which lets
+            // calls remember them as their last hit.
+            std::size_t mockCaseCount = _mockCases.size();
+            _addedMockCaseCount.store(
+                mockCaseCount,
+                std::memory_order_release);
 
-            // Return the CallCount.
-            return callCount;
+            // Create and return a CallCounts for the mock cases sharing the
+            // ownership of _callCounts.
+            return CallCounts(
+                _callCounts,
+                firstMockCaseIndex,
+                mockCaseCount - firstMockCaseIndex);
         }
 
         /// Call this when the method to mock is called.
         ///
+        /// The arguments are taken by reference and are only moved if a fake
+        /// takes them by value, which keeps the cost of a call independent of
+        /// the size of the arguments.
+        ///
         /// @param arguments The arguments of the call.
         /// @return The return value from the first matching mock case.
         /// @throws Throws an UnmockedCallException if the arguments does not
         /// match any mock case.
-        TReturn onCall(TArguments... arguments) {
-            // Create a tuple from the arguments.
-            std::tuple<TArguments...> tupleArguments(
+        TReturn onCall(TArguments&&... arguments) {
+            // Create a tuple of references to the arguments, which lets them
+            // be matched without being copied or moved.
+            std::tuple<TArguments&&...> tupleArguments(
                 std::forward<TArguments>(arguments)...);
 
-            // Declare a pointer for mock cases and initialize it with the top
-            // mock case.
-            InnerMockCase* mockCase = _topMockCase.get();
+            // Record the call if the journal is enabled.
+            CallJournal<TArguments...>* journal
+                = _journal.load(std::memory_order_acquire);
+            if(journal != nullptr) {
+                journal->record(tupleArguments);
+            }
+
+            // Count the call if statistics are enabled.
+            _statistics.onCall();
+
+            // Get the number of mock cases that have been completely added,
+            // which decides whether the last hit is still valid.
+            std::size_t addedMockCaseCount = _addedMockCaseCount.load(
+                std::memory_order_acquire);
+
+            // Declare the index of the mock case handling the call and a
+            // CaseMatch with its return value.
+            std::size_t mockCaseIndex;
+            CaseMatch<TReturn, TArguments...> caseMatch
+                = CaseMatchFactory::noMatch<TReturn, TArguments...>();
+
+            // Declare the number of mock cases checked, which is only used by
+            // the statistics and is optimized away when they are disabled.
+            std::size_t scannedMockCaseCount = 1;
+
+            // Check if the most recently added mock case matches every call.
+            std::size_t catchAllMockCase = _catchAllMockCase.load(
+                std::memory_order_acquire);
+            if(catchAllMockCase != 0) {
+                // If so, let it handle the call without looking at any other
+                // mock case.
+                mockCaseIndex = catchAllMockCase - 1;
+                caseMatch = _mockCases[mockCaseIndex]->matches(tupleArguments);
+                _statistics.onHit();
+            }
+
+            // Otherwise, check the last hit if it is still valid, which only
+            // takes one comparison when the same arguments are used again.
+            else if(findLastHit(
+                addedMockCaseCount,
+                tupleArguments,
+                mockCaseIndex,
+                caseMatch)) {
+                _statistics.onHit();
+            }
+
+            // Otherwise, search the mock cases.
+            else {
+                // Count the search.
+                _statistics.onMiss();
+                scannedMockCaseCount = 0;
 
-            // Iterate while mock cases exist.
-            while(mockCase != nullptr) {
-                // Check if the current mock case matches the arguments.
-                CaseMatch<TReturn> caseMatch = mockCase->_mockCase->matches(
-                    tupleArguments);
+                // Otherwise, look up the most recently added mock case
+                // requiring exactly the provided arguments.
+                std::size_t indexedMockCase;
+                bool indexedMockCaseFound = _argumentsIndex.find(
+                    tupleArguments,
+                    indexedMockCase);
 
-                // Get if a match happened.
-                bool match = caseMatch.isMatch();
+                // Only unindexed mock cases added after the indexed mock case
+                // can take precedence over it.
+                std::size_t minimumIndex = indexedMockCaseFound
+                    ? indexedMockCase + 1
+                    : 0;
 
-                // Check if a match happened.
-                if(match) {
-                    // If so, increase the call count.
-                    mockCase->_callCount->increase();
+                // Find the most recently added unindexed mock case that
+                // matches the arguments, stopping at mock cases without
+                // precedence.
+                UnindexedMockCase* unindexedMockCase
+                    = _unindexedMockCases.findLast(
+                        [&](UnindexedMockCase& mockCase) {
+                            // Stop if the mock case does not have precedence.
+                            if(mockCase.index < minimumIndex) {
+                                return true;
+                            }
 
-                    // And then, return the return value.
-                    return caseMatch
-                        .getReturnValue()
-                        .getReturnValue();
+                            // Otherwise, check if the mock case matches the
+                            // arguments.
+                            scannedMockCaseCount++;
+                            caseMatch = mockCase.mockCase->matches(
+                                tupleArguments);
+                            return caseMatch.isMatch();
+                        });
+
+                // Check if an unindexed mock case matched.
+                if(caseMatch.isMatch()) {
+                    // If so, it handles the call.
+                    mockCaseIndex = unindexedMockCase->index;
                 }
-                else {
-                    // Otherwise, continue with the next mock case.
-                    mockCase = mockCase->_next.get();
+
+                // Otherwise, check if an indexed mock case was found.
+                else if(indexedMockCaseFound) {
+                    // Let the indexed mock case handle the call, which is a
+                    // match since its arguments equal the call's arguments.
+                    mockCaseIndex = indexedMockCase;
+                    caseMatch = _mockCases[mockCaseIndex]->matches(
+                        tupleArguments);
+                    scannedMockCaseCount++;
+                }
+
+                // Remember the mock case if one matched.
+                if(caseMatch.isMatch()) {
+                    storeLastHit(addedMockCaseCount, mockCaseIndex);
                 }
             }
 
+            // Check if a match happened.
+            if(caseMatch.isMatch()) {
+                // Count the match.
+                _statistics.onMatch(scannedMockCaseCount);
+
+                // If so, increase the call count, which also checks the order
+                // of the call if the mock case is in a sequence.
+                (*_callCounts)[mockCaseIndex].increase();
+
+                // And then, return the return value.
+                return caseMatch
+                    .getReturnValue()
+                    .getReturnValue(tupleArguments);
+            }
+
             // No mock case matches the arguments.
+            _statistics.onUnmatchedCall();
 
-            // Create a call string from the arguments.
-            std::string callString = getCallString(std::move(tupleArguments));
+            // Throw an UnknownCallException if the method has no mock cases,
+            // which happens after the mock has been reset.
+            if(addedMockCaseCount == 0) {
+                throw Exception::UnknownCallException();
+            }
 
-            // Throw an UnmockedCallException.
-            throw Exception::UnmockedCallException(callString);
+            // Throw an UnmockedCallException, which keeps the arguments when
+            // possible to make throwing it cheap.
+            throw createUnmockedCallException(
+                tupleArguments,
+                IsCapturable<TArguments...>());
         }
 
     private:
-        /// Create a call string from the provided arguments.
+        /// Stores a new mock case without publishing it as completely added,
+        /// which is left to the caller.
         ///
-        /// @param arguments The arguments of the call.
-        /// @return A string describing how the call was made.
-        std::string getCallString(std::tuple<TArguments...> arguments) const {
-            // Convert the arguments to strings.
-            std::vector<std::string> stringArguments
-                = Apply::apply<std::vector<std::string>, TArguments...>(
-                    std::function<std::vector<std::string> (TArguments...)>(
-                        ToString::toStrings<TArguments...>),
-                    std::move(arguments));
-
-            // Join the argument strings.
-            std::string argumentsString = JoinStrings::joinStrings(
-                ", ",
-                std::move(stringArguments));
-
-            // Create a call string.
-            std::string callString
-                = _methodString
-                + "(" + argumentsString + ")";
-
-            // Return the call string.
-            return callString;
+        /// @param mockCase A mock case to store.
+        /// @return The index of the mock case.
+        std::size_t storeCase(
+            ArenaPointer<ICase<TReturn, TArguments...>> mockCase) {
+            // Get the index of the new mock case.
+            std::size_t mockCaseIndex = _mockCases.size();
+
+            // Get the arguments the mock case requires, if any.
+            const std::tuple<TArguments...>* arguments
+                = mockCase->getArguments();
+
+            // Get a pointer to the mock case.
+            ICase<TReturn, TArguments...>* mockCasePointer = mockCase.get();
+
+            // Check if the mock case matches every call.
+            bool matchesEveryCall = mockCase->matchesEveryCall();
+
+            // Otherwise, stop letting calls go directly to an older mock case
+            // matching every call since the new mock case takes precedence.
+            if(!matchesEveryCall) {
+                _catchAllMockCase.store(0, std::memory_order_relaxed);
+            }
+
+            // Keep older mock cases from being stored as the last hit if the
+            // new mock case does not require specific arguments.
+            if(arguments == nullptr) {
+                _inexactMockCaseEnd.store(
+                    mockCaseIndex + 1,
+                    std::memory_order_relaxed);
+            }
+
+            // Store the mock case and a MutableCallCount for it.
+            _mockCases.emplaceBack(std::move(mockCase));
+            _callCounts->emplaceBack(_concurrency);
+
+            // Try to add the mock case to the index, which replaces any older
+            // mock case requiring the same arguments. The arguments are owned
+            // by the mock case and are therefore kept alive.
+            bool indexed = arguments != nullptr
+                && _argumentsIndex.insert(*arguments, mockCaseIndex);
+
+            // Check if the mock case could be indexed.
+            if(!indexed) {
+                // Otherwise, add it to the mock cases that must be scanned.
+                _unindexedMockCases.emplaceBack(UnindexedMockCase{
+                    mockCasePointer,
+                    mockCaseIndex
+                });
+            }
+
+            // Let calls go directly to the mock case if it matches every call.
+            if(matchesEveryCall) {
+                _catchAllMockCase.store(
+                    mockCaseIndex + 1,
+                    std::memory_order_release);
+            }
+
+            // Return the index of the mock case.
+            return mockCaseIndex;
+        }
+
+        /// Makes room in the index for the entries of a table whose iterators
+        /// can be traversed more than once.
+        ///
+        /// @param begin An iterator to the first entry.
+        /// @param end An iterator past the last entry.
+        /// @tparam TIterator The type of the iterators.
+        template <typename TIterator>
+        void reserveTable(
+            TIterator begin,
+            TIterator end,
+            std::forward_iterator_tag) {
+            // Count the entries and make room for them.
+            _argumentsIndex.reserve(static_cast<std::size_t>(
+                std::distance(begin, end)));
+        }
+
+        /// Does nothing since counting the entries of a table whose iterators
+        /// can only be traversed once would consume them.
+        ///
+        /// @tparam TIterator The type of the iterators.
+        template <typename TIterator>
+        void reserveTable(TIterator, TIterator, std::input_iterator_tag) {
+        }
+
+        /// Lets the mock case that handled the previous call handle a call if
+        /// no other mock case can take precedence over it.
+        ///
+        /// @param addedMockCaseCount The number of completely added mock
+        /// cases when the call was made.
+        /// @param arguments References to the arguments of the call.
+        /// @param mockCaseIndex Assigned the index of the mock case if it
+        /// handles the call.
+        /// @param caseMatch Assigned the CaseMatch of the mock case if it
+        /// handles the call.
+        /// @return True if the mock case handles the call.
+        bool findLastHit(
+            std::size_t addedMockCaseCount,
+            std::tuple<TArguments&&...>& arguments,
+            std::size_t& mockCaseIndex,
+            CaseMatch<TReturn, TArguments...>& caseMatch) const {
+            // Get the last hit, which is only valid if no mock case has been
+            // added since it was stored.
+            std::uint64_t lastHit = _lastHit.load(std::memory_order_acquire);
+            if(lastHit == 0 || lastHit >> 32 != addedMockCaseCount) {
+                return false;
+            }
+
+            // Let the mock case handle the call if it matches.
+            mockCaseIndex = static_cast<std::size_t>(lastHit & 0xffffffff);
+            caseMatch = _mockCases[mockCaseIndex]->matches(arguments);
+            return caseMatch.isMatch();
+        }
+
+        /// Remembers the mock case that handled a call if it will handle every
+        /// call it matches until another mock case is added.
+        ///
+        /// That is the case for the most recently added mock case. It is also
+        /// the case for a mock case requiring specific arguments that are not
+        /// references if every newer mock case also requires specific
+        /// arguments, since any call it matches has the same arguments as the
+        /// call it just handled and every newer mock case has been found not
+        /// to match them. Newer mock cases with matchers or fakes exclude it
+        /// since matchers may give different results for the same arguments,
+        /// and so may referenced arguments, which may change between calls.
+        ///
+        /// @param addedMockCaseCount The number of completely added mock
+        /// cases when the call was made.
+        /// @param mockCaseIndex The index of the mock case.
+        void storeLastHit(
+            std::size_t addedMockCaseCount,
+            std::size_t mockCaseIndex) {
+            // Don't remember mock cases that are still being added or that
+            // can't be stored in the last hit.
+            if(mockCaseIndex >= addedMockCaseCount
+                || addedMockCaseCount > 0xffffffff) {
+                return;
+            }
+
+            // Don't remember mock cases that may match calls with other
+            // arguments, or that newer mock cases with matchers or fakes may
+            // take precedence over, unless they are the most recently added
+            // one. A newer such mock case still being added only makes the
+            // check stricter.
+            if(mockCaseIndex + 1 != addedMockCaseCount
+                && (HasReference<TArguments...>::value
+                    || _mockCases[mockCaseIndex]->getArguments() == nullptr
+                    || mockCaseIndex < _inexactMockCaseEnd.load(
+                        std::memory_order_relaxed))) {
+                return;
+            }
+
+            // Store the mock case together with the number of mock cases,
+            // unless it is already stored, which keeps threads calling with
+            // the same arguments from writing to the same cache line.
+            std::uint64_t lastHit
+                = static_cast<std::uint64_t>(addedMockCaseCount) << 32
+                | mockCaseIndex;
+            if(_lastHit.load(std::memory_order_relaxed) != lastHit) {
+                _lastHit.store(lastHit, std::memory_order_release);
+            }
+        }
+
+        /// Creates an UnmockedCallException keeping the arguments of a call
+        /// to only create a message if it is needed.
+        ///
+        /// @param arguments References to the arguments of the call, which are
+        /// moved unless they are references.
+        /// @return The created UnmockedCallException.
+        Exception::UnmockedCallException createUnmockedCallException(
+            std::tuple<TArguments&&...>& arguments,
+            std::true_type) const {
+            // Create the exception with values created from the arguments,
+            // which outlive the call.
+            return Exception::UnmockedCallException(
+                _methodString,
+                std::tuple<typename std::decay<TArguments>::type...>(
+                    std::move(arguments)));
+        }
+
+        /// Creates an UnmockedCallException with a message created
+        /// immediately since the arguments can't be kept after the call.
+        ///
+        /// @param arguments References to the arguments of the call, which are
+        /// moved unless they are references.
+        /// @return The created UnmockedCallException.
+        Exception::UnmockedCallException createUnmockedCallException(
+            std::tuple<TArguments&&...>& arguments,
+            std::false_type) const {
+            // Take the arguments, create a call string from them and then an
+            // exception with it.
+            std::tuple<TArguments...> ownedArguments(std::move(arguments));
+            return Exception::UnmockedCallException(
+                CallString::create(*_methodString, ownedArguments));
         }
 };
 
+IMOCK_STATISTICS_NAMESPACE_END
 }
 }
@@ -1,13 +1,15 @@
 #pragma once
 
-#include <functional>
-
+#include <internal/Arena.hpp>
 #include <internal/CaseMatch.hpp>
 #include <internal/CaseMatchFactory.hpp>
 #include <internal/ICase.hpp>
+#include <internal/IReturnValue.hpp>
+#include <internal/StatisticsNamespace.hpp>
 
 namespace IMock {
 namespace Internal {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
 
 /// An ICase checking if calls match provided arguments.
 ///
@@ -19,41 +21,57 @@ class MockWithArgumentsCase : public ICase<TReturn, TArguments...> {
         /// The arguments to check calls with.
         std::tuple<TArguments...> _arguments;
 
-        /// A callback to call if the arguments match.
-        std::function<CaseMatch<TReturn> (std::tuple<TArguments...>)> _fake;
+        /// The return value to use if the arguments match.
+        ArenaPointer<IReturnValue<TReturn, TArguments...>> _returnValue;
 
     public:
         /// Creates a MockWithArgumentsCase.
         ///
         /// @param arguments The arguments to check calls with.
-        /// @param fake A callback to call if the arguments match.
+        /// @param returnValue The return value to use if the arguments match.
         MockWithArgumentsCase(
             std::tuple<TArguments...> arguments,
-            std::function<CaseMatch<TReturn> (std::tuple<TArguments...>)> fake)
+            ArenaPointer<IReturnValue<TReturn, TArguments...>> returnValue)
             : _arguments(std::move(arguments))
-            , _fake(std::move(fake)) {
+            , _returnValue(std::move(returnValue)) {
             }
 
         /// Checks if the provided arguments matches the provided arguments.
         ///
-        /// @param arguments The arguments the mocked method was called with,
-        /// which will be moved to _fake if a match is made.
+        /// @param arguments The arguments the mocked method was called with.
         /// @return A CaseMatch indicating if the arguments resulted in a match.
-        CaseMatch<TReturn> matches(std::tuple<TArguments...>& arguments)
-            override {
+        CaseMatch<TReturn, TArguments...> matches(
+            std::tuple<TArguments&&...>& arguments) override {
             // Check if the call arguments matches the mock case's arguments.
             if(arguments == _arguments) {
-                // Call _fake and return its return value if a match has been
-                // made. The arguments are moved to _fake as they will never be
-                // read again.
-                return _fake(std::move(arguments));
+                // Return a CaseMatch with _returnValue if a match has been
+                // made.
+                return CaseMatchFactory::match(*_returnValue);
             }
             else {
                 // Return a CaseMatch indicating no match has been made.
-                return CaseMatchFactory::noMatch<TReturn>();
+                return CaseMatchFactory::noMatch<TReturn, TArguments...>();
             }
         }
+
+        /// Gets the arguments calls must be equal to for the case to match.
+        ///
+        /// @return A pointer to the arguments to check calls with.
+        const std::tuple<TArguments...>* getArguments() const override {
+            // Return a pointer to the arguments.
+            return &_arguments;
+        }
+
+        /// Checks if the case matches every call, which is the case if the
+        /// method has no arguments.
+        ///
+        /// @return True if the method has no arguments.
+        bool matchesEveryCall() const override {
+            // Every call to a method without arguments has equal arguments.
+            return sizeof...(TArguments) == 0;
+        }
 };
 
+IMOCK_STATISTICS_NAMESPACE_END
 }
 }
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <internal/Arena.hpp>
+#include <internal/CaseMatch.hpp>
+#include <internal/CaseMatchFactory.hpp>
+#include <internal/ICase.hpp>
+#include <internal/IReturnValue.hpp>
+#include <internal/StatisticsNamespace.hpp>
+#include <Matcher.hpp>
+
+namespace IMock {
+namespace Internal {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
+
+/// An ICase checking if calls match provided Matcher instances, one per
+/// argument.
+///
+/// The mock case does not require specific arguments, which means it is never
+/// indexed and is instead scanned on calls together with other such mock
+/// cases.
+///
+/// @tparam TReturn The return type of the mocked method.
+/// @tparam TArguments The types of the arguments of the mocked method.
+template <typename TReturn, typename ...TArguments>
+class MockWithMatchersCase : public ICase<TReturn, TArguments...> {
+    private:
+        /// Checks the arguments of a call with the matchers, starting with the
+        /// argument with the provided index.
+        ///
+        /// @tparam index The index of the first argument to check.
+        /// @tparam end Whether the index is past the last argument.
+        template <std::size_t index,
+            bool end = index == sizeof...(TArguments)>
+        struct MatchArguments {
+            /// Checks the arguments starting at index.
+            ///
+            /// @param matchers The matchers to check the arguments with.
+            /// @param arguments The arguments to check.
+            /// @return True if every argument matches.
+            static bool matches(
+                const std::tuple<Matcher<
+                    typename std::decay<TArguments>::type>...>& matchers,
+                const std::tuple<TArguments&&...>& arguments) {
+                // Check the current argument and then the remaining ones.
+                return std::get<index>(matchers).matches(
+                        std::get<index>(arguments))
+                    && MatchArguments<index + 1>::matches(matchers, arguments);
+            }
+        };
+
+        //! @cond Doxygen_Suppress
+        template <std::size_t index>
+        struct MatchArguments<index, true> {
+            static bool matches(
+                const std::tuple<Matcher<
+                    typename std::decay<TArguments>::type>...>&,
+                const std::tuple<TArguments&&...>&) {
+                return true;
+            }
+        };
+        //! @endcond
+
+        /// The matchers to check calls with.
+        std::tuple<Matcher<typename std::decay<TArguments>::type>...>
+            _matchers;
+
+        /// The return value to use if the arguments match.
+        ArenaPointer<IReturnValue<TReturn, TArguments...>> _returnValue;
+
+    public:
+        /// Creates a MockWithMatchersCase.
+        ///
+        /// @param matchers The matchers to check calls with.
+        /// @param returnValue The return value to use if the arguments match.
+        MockWithMatchersCase(
+            std::tuple<Matcher<typename std::decay<TArguments>::type>...>
+                matchers,
+            ArenaPointer<IReturnValue<TReturn, TArguments...>> returnValue)
+            : _matchers(std::move(matchers))
+            , _returnValue(std::move(returnValue)) {
+            }
+
+        /// Checks if the provided arguments are matched by the matchers.
+        ///
+        /// @param arguments The arguments the mocked method was called with.
+        /// @return A CaseMatch indicating if the arguments resulted in a match.
+        CaseMatch<TReturn, TArguments...> matches(
+            std::tuple<TArguments&&...>& arguments) override {
+            // Check if every argument is matched by its matcher.
+            if(MatchArguments<0>::matches(_matchers, arguments)) {
+                // Return a CaseMatch with _returnValue if a match has been
+                // made.
+                return CaseMatchFactory::match(*_returnValue);
+            }
+            else {
+                // Return a CaseMatch indicating no match has been made.
+                return CaseMatchFactory::noMatch<TReturn, TArguments...>();
+            }
+        }
+};
+
+IMOCK_STATISTICS_NAMESPACE_END
+}
+}
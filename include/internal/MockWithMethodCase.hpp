@@ -1,47 +1,54 @@
 #pragma once
 
-#include <functional>
-
+#include <internal/Arena.hpp>
 #include <internal/CaseMatch.hpp>
 #include <internal/CaseMatchFactory.hpp>
 #include <internal/ICase.hpp>
+#include <internal/IReturnValue.hpp>
+#include <internal/StatisticsNamespace.hpp>
 
 namespace IMock {
 namespace Internal {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
 
-/// An ICase always calling a provided callback.
+/// An ICase matching every call.
 ///
 /// @tparam TReturn The return type of the mocked method.
 /// @tparam TArguments The types of the arguments of the mocked method.
 template <typename TReturn, typename ...TArguments>
 class MockWithMethodCase : public ICase<TReturn, TArguments...> {
     private:
-        /// A callback to be called.
-        std::function<TReturn (TArguments...)> _fake;
+        /// The return value to use for every call.
+        ArenaPointer<IReturnValue<TReturn, TArguments...>> _returnValue;
 
     public:
         /// Creates a MockWithMethodCase.
         ///
-        /// @param fake A callback to be called.
+        /// @param returnValue The return value to use for every call.
         MockWithMethodCase(
-            std::function<TReturn (TArguments...)> fake)
-            : _fake(std::move(fake)) {
+            ArenaPointer<IReturnValue<TReturn, TArguments...>> returnValue)
+            : _returnValue(std::move(returnValue)) {
             }
 
         /// Always matches the arguments.
         ///
-        /// @param arguments The arguments the mocked method was called with,
-        /// which will be moved to _fake.
-        /// @return A CaseMatch indicating a match using the return value from
-        /// _fake.
-        CaseMatch<TReturn> matches(std::tuple<TArguments...>& arguments)
-            override {
-            // Return a CaseMatch for the fake.
-            return Internal::CaseMatchFactory::matchFake(
-                _fake,
-                std::move(arguments));
+        /// @param arguments The arguments the mocked method was called with.
+        /// @return A CaseMatch indicating a match using _returnValue.
+        CaseMatch<TReturn, TArguments...> matches(
+            std::tuple<TArguments&&...>& arguments) override {
+            // Return a CaseMatch with _returnValue.
+            return CaseMatchFactory::match(*_returnValue);
+        }
+
+        /// Always matches every call.
+        ///
+        /// @return True.
+        bool matchesEveryCall() const override {
+            // Return true since every call is matched.
+            return true;
         }
 };
 
+IMOCK_STATISTICS_NAMESPACE_END
 }
 }
@@ -1,31 +1,257 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include <internal/Sequence.hpp>
+#include <Concurrency.hpp>
+
 namespace IMock {
 namespace Internal {
 
-/// Contains a call count that can be increased and retrieved.
+/// Contains a call count that can be increased and retrieved, as well as the
+/// step of the mock case in a Sequence, if any.
+///
+/// In concurrent mode, the call count is split into shards that are each
+/// increased by a subset of the threads once two threads have been found to
+/// increase it at the same time. Every shard is placed on its own cache line,
+/// which keeps threads calling the same mock case from contending for the same
+/// cache line. The shards are summed when the call count is retrieved. Mock
+/// cases that are never called from several threads at once therefore never
+/// allocate any shards.
 class MutableCallCount {
     private:
-        // The call count.
-        int _callCount;
+        /// The assumed size of a cache line.
+        static const std::size_t cacheLineSize = 64;
+
+        /// The maximum number of shards.
+        static const std::size_t maxShardCount = 256;
+
+        /// A part of the call count occupying a whole cache line.
+        struct alignas(cacheLineSize) Shard {
+            /// The part of the call count.
+            std::atomic<int> callCount;
+        };
+
+        // The call count until it is sharded, which is atomic to let other
+        // threads read it while it is being increased.
+        std::atomic<int> _callCount;
+
+        /// Whether the call count may be increased by several threads at once.
+        bool _concurrent;
+
+        /// The shards once the call count has been increased by several
+        /// threads at once and nullptr otherwise.
+        std::atomic<Shard*> _shards;
+
+        /// The memory the shards have been placed in, which is only used to
+        /// delete it.
+        char* _shardMemory;
+
+        /// The Sequence the mock case is a step in, or nullptr.
+        std::shared_ptr<Sequence> _sequence;
+
+        /// The step of the mock case in _sequence.
+        std::size_t _sequenceStep;
+
+        /// Gets the number of shards to use in concurrent mode, which is the
+        /// number of hardware threads rounded up to a power of two.
+        ///
+        /// @return The number of shards.
+        static std::size_t getShardCount() {
+            // Calculate the number of shards once.
+            static const std::size_t shardCount = []() {
+                // Get the number of hardware threads, which may be unknown.
+                std::size_t threadCount = std::thread::hardware_concurrency();
+
+                // Round it up to a power of two within the limits.
+                std::size_t shardCount = 1;
+                while(shardCount < threadCount
+                    && shardCount < maxShardCount) {
+                    shardCount *= 2;
+                }
+                return shardCount;
+            }();
+
+            // Return the number of shards.
+            return shardCount;
+        }
+
+        /// Allocates the shards unless another thread already has. Calls keep
+        /// using the unsharded call count if the shards can't be allocated.
+        void allocateShards() {
+            // Allocate memory for the shards without throwing, with room to
+            // place them at the start of a cache line since new is not
+            // required to align them that strictly.
+            std::size_t size = getShardCount() * sizeof(Shard);
+            std::size_t space = size + alignof(Shard) - 1;
+            char* memory = new(std::nothrow) char[space];
+            if(memory == nullptr) {
+                return;
+            }
+
+            // Align the shards, which always fits in the allocated memory.
+            void* alignedMemory = memory;
+            std::align(alignof(Shard), size, alignedMemory, space);
+            Shard* shards = static_cast<Shard*>(alignedMemory);
+
+            // Create every shard and initialize it with zero.
+            for(std::size_t shard = 0; shard < getShardCount(); shard++) {
+                new(&shards[shard]) Shard();
+                shards[shard].callCount.store(0, std::memory_order_relaxed);
+            }
+
+            // Publish the shards, unless another thread already has, in which
+            // case their memory is deleted. The memory is only read by the
+            // destructor, which runs after every call has been made.
+            Shard* expected = nullptr;
+            if(_shards.compare_exchange_strong(
+                expected,
+                shards,
+                std::memory_order_release,
+                std::memory_order_relaxed)) {
+                _shardMemory = memory;
+            }
+            else {
+                delete[] memory;
+            }
+        }
+
+        /// Gets a number identifying the calling thread. The numbers are given
+        /// out in the order threads first ask for one, which spreads
+        /// concurrently running threads evenly over the shards.
+        ///
+        /// @return The number of the calling thread.
+        static std::size_t getThreadNumber() {
+            // Give every thread the next number the first time it asks.
+            static std::atomic<std::size_t> nextThreadNumber(0);
+            static thread_local std::size_t threadNumber
+                = nextThreadNumber.fetch_add(1, std::memory_order_relaxed);
+
+            // Return the number of the thread.
+            return threadNumber;
+        }
 
     public:
         /// Creates a MutableCallCount by initializing the call count with zero.
-        MutableCallCount()
-            : _callCount(0) {
+        ///
+        /// @param concurrency Whether the call count may be increased by
+        /// several threads at once.
+        MutableCallCount(
+            Concurrency concurrency = Concurrency::SingleThreaded)
+            : _callCount(0)
+            , _concurrent(concurrency == Concurrency::Concurrent)
+            , _shards(nullptr)
+            , _shardMemory(nullptr)
+            , _sequenceStep(0) {
         }
 
-        /// Increases the call count by one.
+        /// MutableCallCount cannot be copied.
+        MutableCallCount(const MutableCallCount&) = delete;
+
+        /// MutableCallCount cannot be copied.
+        MutableCallCount& operator = (const MutableCallCount&) = delete;
+
+        /// Destructs the MutableCallCount and its shards, if any.
+        ~MutableCallCount() noexcept {
+            // Delete the memory of the shards, which are trivially
+            // destructible.
+            delete[] _shardMemory;
+        }
+
+        /// Increases the call count by one after checking the call is made in
+        /// order if the mock case is a step in a Sequence.
+        ///
+        /// In concurrent mode, the first increase made at the same time as
+        /// another one allocates the shards.
+        ///
+        /// @throws Throws a WrongCallOrderException if the call is out of
+        /// order, in which case the call count is not increased.
         void increase() {
-            _callCount++;
+            // Check the order of the call if the mock case is a step in a
+            // Sequence.
+            if(_sequence != nullptr) {
+                _sequence->onCall(_sequenceStep);
+            }
+
+            // Check if the call count may be increased by several threads at
+            // once.
+            if(!_concurrent) {
+                // If not, increase the call count without a read-modify-write
+                // operation, which is as cheap as increasing a plain int.
+                _callCount.store(
+                    _callCount.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+                return;
+            }
+
+            // Check if the call count is sharded.
+            Shard* shards = _shards.load(std::memory_order_acquire);
+            if(shards != nullptr) {
+                // If so, atomically increase the calling thread's shard.
+                shards[getThreadNumber() & (getShardCount() - 1)]
+                    .callCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            // Otherwise, try to increase the call count, which only fails if
+            // another thread increased it at the same time.
+            int callCount = _callCount.load(std::memory_order_relaxed);
+            if(!_callCount.compare_exchange_strong(
+                callCount,
+                callCount + 1,
+                std::memory_order_relaxed)) {
+                // Count the call anyway and shard the call count, which keeps
+                // the threads from contending for it from now on.
+                _callCount.fetch_add(1, std::memory_order_relaxed);
+                allocateShards();
+            }
         }
 
         /// Gets the call count.
         ///
         /// @return The call count.
         int getCallCount() const {
+            // Get the call count from before it was sharded, if ever.
+            int callCount = _callCount.load(std::memory_order_relaxed);
+
+            // Add the shards, if any.
+            Shard* shards = _shards.load(std::memory_order_acquire);
+            if(shards != nullptr) {
+                for(std::size_t shard = 0; shard < getShardCount(); shard++) {
+                    callCount += shards[shard].callCount.load(
+                        std::memory_order_relaxed);
+                }
+            }
+
             // Return the call count.
-            return _callCount;
+            return callCount;
+        }
+
+        /// Makes the mock case a step in a Sequence.
+        ///
+        /// This must be done before the mock case is called.
+        ///
+        /// @param sequence The Sequence.
+        /// @param sequenceStep The step of the mock case in the Sequence.
+        void setSequence(
+            std::shared_ptr<Sequence> sequence,
+            std::size_t sequenceStep) {
+            // Store the Sequence and the step.
+            _sequence = std::move(sequence);
+            _sequenceStep = sequenceStep;
+        }
+
+        /// Checks if the mock case is a step in a Sequence.
+        ///
+        /// @return True if the mock case is a step in a Sequence.
+        bool hasSequence() const {
+            // Check if there is a Sequence.
+            return _sequence != nullptr;
         }
 };
 
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include <MemoryResource.hpp>
+
+namespace IMock {
+namespace Internal {
+
+/// A MemoryResource using the global operator new and operator delete, which
+/// is used by a Mock unless another MemoryResource is provided.
+class NewDeleteMemoryResource : public MemoryResource {
+    public:
+        /// Gets the shared instance of NewDeleteMemoryResource.
+        ///
+        /// @return A reference to the instance.
+        static NewDeleteMemoryResource& getInstance() {
+            // Create the instance once and return it.
+            static NewDeleteMemoryResource instance;
+            return instance;
+        }
+
+        /// Allocates memory using operator new.
+        ///
+        /// @param size The number of bytes to allocate.
+        /// @return A pointer to the allocated memory.
+        void* allocate(std::size_t size, std::size_t) override {
+            // Allocate the memory, which is suitably aligned for any type
+            // without extended alignment.
+            return ::operator new(size);
+        }
+
+        /// Deallocates memory using operator delete.
+        ///
+        /// @param memory A pointer to the memory to deallocate.
+        void deallocate(void* memory, std::size_t, std::size_t)
+            noexcept override {
+            // Deallocate the memory.
+            ::operator delete(memory);
+        }
+};
+
+}
+}
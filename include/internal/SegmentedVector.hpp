@@ -0,0 +1,262 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace IMock {
+namespace Internal {
+
+/// An append-only sequence of values stored in a small number of contiguous
+/// segments.
+///
+/// Every segment is twice as large as the previous one, which means values are
+/// never moved when the sequence grows and references to them stay valid for
+/// the lifetime of the SegmentedVector.
+///
+/// One thread at a time may add values while other threads read them. A value
+/// is only visible to readers through size() and findLast() once it has been
+/// completely created.
+///
+/// @tparam TValue The type of the stored values.
+template <typename TValue>
+class SegmentedVector {
+    private:
+        /// The base two logarithm of the size of the first segment.
+        static const std::size_t firstSegmentSizeLog2 = 4;
+
+        /// The size of the first segment.
+        static const std::size_t firstSegmentSize
+            = std::size_t(1) << firstSegmentSizeLog2;
+
+        /// The maximum number of segments, which is enough to store as many
+        /// values as can be addressed.
+        static const std::size_t maxSegmentCount
+            = sizeof(std::size_t) * 8 - firstSegmentSizeLog2;
+
+        /// The segments, of which only the first ones needed to store _size
+        /// values have been allocated.
+        TValue* _segments[maxSegmentCount];
+
+        /// The number of stored values.
+        std::atomic<std::size_t> _size;
+
+        /// Calculates the base two logarithm of a value rounded down.
+        ///
+        /// @param value The value to calculate the logarithm of, which must
+        /// not be zero.
+        /// @return The logarithm of the value.
+        static std::size_t log2(std::size_t value) {
+            #if defined(__GNUC__)
+
+            // Use a builtin counting the leading zeros if available.
+            return sizeof(unsigned long long) * 8 - 1
+                - __builtin_clzll(value);
+            #else
+
+            // Otherwise, shift the value until it is one.
+            std::size_t result = 0;
+            while(value >>= 1) {
+                result++;
+            }
+            return result;
+            #endif
+        }
+
+        /// Gets the segment containing the value with the provided index.
+        ///
+        /// @param index The index of the value.
+        /// @return The index of the segment.
+        static std::size_t getSegmentIndex(std::size_t index) {
+            // Offset the index by the size of the first segment, which makes
+            // the segment index the logarithm of the offset index minus the
+            // logarithm of the first segment size.
+            return log2(index + firstSegmentSize) - firstSegmentSizeLog2;
+        }
+
+        /// Gets the size of a segment.
+        ///
+        /// @param segmentIndex The index of the segment.
+        /// @return The number of values the segment can hold.
+        static std::size_t getSegmentSize(std::size_t segmentIndex) {
+            // Double the size of the first segment once for each segment.
+            return firstSegmentSize << segmentIndex;
+        }
+
+        /// Gets the index of the first value in a segment.
+        ///
+        /// @param segmentIndex The index of the segment.
+        /// @return The index of the first value in the segment.
+        static std::size_t getSegmentStart(std::size_t segmentIndex) {
+            // The previous segments hold the size of this segment minus the
+            // size of the first segment.
+            return getSegmentSize(segmentIndex) - firstSegmentSize;
+        }
+
+    public:
+        /// Creates an empty SegmentedVector.
+        SegmentedVector()
+            : _segments()
+            , _size(0) {
+        }
+
+        /// SegmentedVector cannot be copied.
+        SegmentedVector(const SegmentedVector&) = delete;
+
+        /// SegmentedVector cannot be copied.
+        SegmentedVector& operator = (const SegmentedVector&) = delete;
+
+        /// Destructs the SegmentedVector by destructing every value and
+        /// deallocating the segments.
+        ~SegmentedVector() noexcept {
+            // Destruct the values.
+            clear();
+
+            // Deallocate every segment that has been allocated.
+            for(std::size_t segmentIndex = 0;
+                segmentIndex < maxSegmentCount
+                    && _segments[segmentIndex] != nullptr;
+                segmentIndex++) {
+                ::operator delete(_segments[segmentIndex]);
+            }
+        }
+
+        /// Creates a value at the end of the sequence.
+        ///
+        /// @param arguments The arguments used to create the value.
+        /// @return A reference to the created value.
+        /// @tparam TArguments The types of the arguments used to create the
+        /// value.
+        template <typename ...TArguments>
+        TValue& emplaceBack(TArguments&&... arguments) {
+            // Get the current size, which only the calling thread changes.
+            std::size_t size = _size.load(std::memory_order_relaxed);
+
+            // Get the segment to store the value in.
+            std::size_t segmentIndex = getSegmentIndex(size);
+
+            // Check if the segment has been allocated.
+            if(_segments[segmentIndex] == nullptr) {
+                // Allocate the segment if that's not the case. Segments
+                // allocated before a call to clear are reused.
+                _segments[segmentIndex] = static_cast<TValue*>(
+                    ::operator new(
+                        getSegmentSize(segmentIndex) * sizeof(TValue)));
+            }
+
+            // Create the value in the segment.
+            TValue* value = new(_segments[segmentIndex]
+                + (size - getSegmentStart(segmentIndex)))
+                TValue(std::forward<TArguments>(arguments)...);
+
+            // Increase the size, which publishes the value to readers.
+            _size.store(size + 1, std::memory_order_release);
+
+            // Return a reference to the value.
+            return *value;
+        }
+
+        /// Gets the value with the provided index.
+        ///
+        /// @param index The index of the value, which must be less than
+        /// size().
+        /// @return A reference to the value.
+        TValue& operator [] (std::size_t index) {
+            // Get the segment containing the value.
+            std::size_t segmentIndex = getSegmentIndex(index);
+
+            // Return the value within the segment.
+            return _segments[segmentIndex][index
+                - getSegmentStart(segmentIndex)];
+        }
+
+        /// Gets the value with the provided index.
+        ///
+        /// @param index The index of the value, which must be less than
+        /// size().
+        /// @return A constant reference to the value.
+        const TValue& operator [] (std::size_t index) const {
+            // Forward the call to the non-constant operator.
+            return const_cast<SegmentedVector&>(*this)[index];
+        }
+
+        /// Finds the last value fulfilling a predicate by walking through the
+        /// segments from the last value to the first.
+        ///
+        /// @param predicate A callable taking a reference to a value and
+        /// returning true if the value is the one to find.
+        /// @return A pointer to the found value or nullptr if no value
+        /// fulfills the predicate.
+        /// @tparam TPredicate The type of the predicate.
+        template <typename TPredicate>
+        TValue* findLast(TPredicate predicate) {
+            // Get the number of values that have been published.
+            std::size_t size = this->size();
+
+            // Return immediately if there are no values.
+            if(size == 0) {
+                return nullptr;
+            }
+
+            // Get the segment containing the last value and the number of
+            // values up to the end of the values in that segment.
+            std::size_t segmentIndex = getSegmentIndex(size - 1);
+            std::size_t end = size;
+
+            // Process every segment from the last one.
+            while(true) {
+                // Get the first value in the segment and the position after
+                // the last one.
+                TValue* segment = _segments[segmentIndex];
+                TValue* value = segment
+                    + (end - getSegmentStart(segmentIndex));
+
+                // Process the values in the segment backwards.
+                while(value != segment) {
+                    // Continue with the previous value.
+                    value--;
+
+                    // Return the value if it fulfills the predicate.
+                    if(predicate(*value)) {
+                        return value;
+                    }
+                }
+
+                // Stop when the first segment has been processed.
+                if(segmentIndex == 0) {
+                    return nullptr;
+                }
+
+                // Otherwise, continue with the previous segment, which is
+                // full.
+                end = getSegmentStart(segmentIndex);
+                segmentIndex--;
+            }
+        }
+
+        /// Gets the number of stored values.
+        ///
+        /// @return The number of stored values.
+        std::size_t size() const {
+            // Return the size.
+            return _size.load(std::memory_order_acquire);
+        }
+
+        /// Destructs every value while keeping the segments allocated.
+        ///
+        /// This must not be called while other threads read the values.
+        void clear() noexcept {
+            // Destruct the values in the order they were created.
+            std::size_t size = _size.load(std::memory_order_relaxed);
+            for(std::size_t index = 0; index < size; index++) {
+                (*this)[index].~TValue();
+            }
+
+            // Reset the size.
+            _size.store(0, std::memory_order_relaxed);
+        }
+};
+
+}
+}
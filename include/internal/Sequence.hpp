@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include <exception/WrongCallOrderException.hpp>
+
+namespace IMock {
+namespace Internal {
+
+/// Keeps track of the progress through a sequence of mock cases that must be
+/// called in order.
+///
+/// Every call to a mock case in the sequence is checked in constant time by
+/// comparing its step with the most recently called step.
+class Sequence {
+    private:
+        /// The number of steps in the sequence.
+        std::size_t _stepCount;
+
+        /// The most recently called step, where steps are numbered from one
+        /// and zero means no step has been called.
+        std::atomic<std::size_t> _calledStep;
+
+    public:
+        /// Creates a Sequence without any steps.
+        Sequence()
+            : _stepCount(0)
+            , _calledStep(0) {
+        }
+
+        /// Adds a step to the end of the sequence.
+        ///
+        /// @return The number of the added step.
+        std::size_t addStep() {
+            // Increase and return the number of steps.
+            return ++_stepCount;
+        }
+
+        /// Call this when a mock case in the sequence is called.
+        ///
+        /// The call is in order if its step is the most recently called step,
+        /// which means the step is called again, or the step after it.
+        ///
+        /// @param step The step of the called mock case.
+        /// @throws Throws a WrongCallOrderException if the call is out of
+        /// order.
+        void onCall(std::size_t step) {
+            // Get the most recently called step.
+            std::size_t calledStep = _calledStep.load(
+                std::memory_order_acquire);
+
+            // Loop until the call has been checked, which only happens more
+            // than once if another thread advances the sequence at the same
+            // time.
+            while(true) {
+                // The call is in order without advancing the sequence if the
+                // step is called again.
+                if(step == calledStep) {
+                    return;
+                }
+
+                // Throw a WrongCallOrderException unless the call is to the
+                // next step.
+                if(step != calledStep + 1) {
+                    throw Exception::WrongCallOrderException(
+                        step,
+                        calledStep);
+                }
+
+                // Advance the sequence unless another thread changed it, in
+                // which case calledStep is updated and the call checked again.
+                if(_calledStep.compare_exchange_weak(
+                    calledStep,
+                    step,
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire)) {
+                    return;
+                }
+            }
+        }
+
+        /// Gets the number of steps in the sequence.
+        ///
+        /// @return The number of steps.
+        std::size_t getStepCount() const {
+            // Return the number of steps.
+            return _stepCount;
+        }
+
+        /// Gets the most recently called step.
+        ///
+        /// @return The number of the step or zero if no step has been called.
+        std::size_t getCalledStep() const {
+            // Return the most recently called step.
+            return _calledStep.load(std::memory_order_acquire);
+        }
+};
+
+}
+}
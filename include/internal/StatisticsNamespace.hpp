@@ -0,0 +1,15 @@
+#pragma once
+
+/// Opens the inline namespace holding every type whose layout depends on
+/// whether IMOCK_STATISTICS is defined. The namespace is named after the
+/// setting, which gives the types different mangled names in translation
+/// units including IMock with different settings and makes mixing them fail
+/// when linking instead of silently breaking the one definition rule.
+#if defined(IMOCK_STATISTICS)
+#define IMOCK_STATISTICS_NAMESPACE_BEGIN inline namespace Statistics {
+#else
+#define IMOCK_STATISTICS_NAMESPACE_BEGIN inline namespace NoStatistics {
+#endif
+
+/// Closes the namespace opened by IMOCK_STATISTICS_NAMESPACE_BEGIN.
+#define IMOCK_STATISTICS_NAMESPACE_END }
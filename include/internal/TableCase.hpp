@@ -0,0 +1,89 @@
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include <internal/CaseMatch.hpp>
+#include <internal/CaseMatchFactory.hpp>
+#include <internal/ICase.hpp>
+#include <internal/IReturnValue.hpp>
+#include <internal/StatisticsNamespace.hpp>
+
+namespace IMock {
+namespace Internal {
+IMOCK_STATISTICS_NAMESPACE_BEGIN
+
+/// An ICase checking if calls match provided arguments and returning a
+/// provided value, which is used for mock cases added from a table.
+///
+/// The mock case is its own return value, which means it is created as a
+/// single object.
+///
+/// @tparam TReturn The return type of the mocked method.
+/// @tparam TArguments The types of the arguments of the mocked method.
+template <typename TReturn, typename ...TArguments>
+class TableCase
+    : public ICase<TReturn, TArguments...>
+    , public IReturnValue<TReturn, TArguments...> {
+    private:
+        /// The arguments to check calls with.
+        std::tuple<TArguments...> _arguments;
+
+        /// The value to return if the arguments match.
+        TReturn _returnValue;
+
+    public:
+        /// Creates a TableCase.
+        ///
+        /// @param arguments The arguments to check calls with.
+        /// @param returnValue The value to return if the arguments match.
+        TableCase(std::tuple<TArguments...> arguments, TReturn returnValue)
+            : _arguments(std::move(arguments))
+            , _returnValue(std::forward<TReturn>(returnValue)) {
+        }
+
+        /// Checks if the provided arguments matches the provided arguments.
+        ///
+        /// @param arguments The arguments the mocked method was called with.
+        /// @return A CaseMatch indicating if the arguments resulted in a match.
+        CaseMatch<TReturn, TArguments...> matches(
+            std::tuple<TArguments&&...>& arguments) override {
+            // Check if the call arguments matches the mock case's arguments.
+            if(arguments == _arguments) {
+                // Return a CaseMatch with the mock case itself as the return
+                // value if a match has been made.
+                return CaseMatchFactory::match(
+                    static_cast<IReturnValue<TReturn, TArguments...>&>(*this));
+            }
+            else {
+                // Return a CaseMatch indicating no match has been made.
+                return CaseMatchFactory::noMatch<TReturn, TArguments...>();
+            }
+        }
+
+        /// Gets the arguments calls must be equal to for the case to match.
+        ///
+        /// @return A pointer to the arguments to check calls with.
+        const std::tuple<TArguments...>* getArguments() const override {
+            // Return a pointer to the arguments.
+            return &_arguments;
+        }
+
+        /// Checks if the case matches every call, which is the case if the
+        /// method has no arguments.
+        ///
+        /// @return True if the method has no arguments.
+        bool matchesEveryCall() const override {
+            // Every call to a method without arguments has equal arguments.
+            return sizeof...(TArguments) == 0;
+        }
+
+        TReturn getReturnValue(std::tuple<TArguments&&...>&) override {
+            // Return the stored value.
+            return _returnValue;
+        }
+};
+
+IMOCK_STATISTICS_NAMESPACE_END
+}
+}
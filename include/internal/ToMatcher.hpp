@@ -0,0 +1,66 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include <Matcher.hpp>
+
+namespace IMock {
+namespace Internal {
+
+/// Checks if any of the provided types is a Matcher.
+///
+/// @tparam TValues The types to check.
+template <typename ...TValues>
+struct ContainsMatcher;
+
+//! @cond Doxygen_Suppress
+template <>
+struct ContainsMatcher<> : std::false_type {
+};
+
+template <typename TValue, typename ...TValues>
+struct ContainsMatcher<TValue, TValues...> : std::integral_constant<bool,
+    IsMatcher<typename std::decay<TValue>::type>::value
+    || ContainsMatcher<TValues...>::value> {
+};
+//! @endcond
+
+/// Converts values passed to with() to Matcher instances.
+///
+/// @tparam TValue The type of the argument without references and const.
+template <typename TValue>
+class ToMatcher {
+    public:
+        /// ToMatcher is not supposed to be instantiated since it only contains
+        /// static methods.
+        ToMatcher() = delete;
+
+        /// Returns the provided Matcher unchanged.
+        ///
+        /// @param matcher The Matcher.
+        /// @return The Matcher.
+        static Matcher<TValue> toMatcher(Matcher<TValue> matcher) {
+            // Return the Matcher.
+            return matcher;
+        }
+
+        /// Creates a Matcher matching values equal to the provided value.
+        ///
+        /// @param value The value to match.
+        /// @return The created Matcher.
+        /// @tparam TExpected The type of the value to match, which must be
+        /// implicitly convertible to TValue.
+        template <typename TExpected>
+        static typename std::enable_if<
+            !IsMatcher<typename std::decay<TExpected>::type>::value
+                && std::is_convertible<TExpected, TValue>::value,
+            Matcher<TValue>>::type toMatcher(TExpected&& value) {
+            // Create a Matcher comparing with the value, which is implicitly
+            // converted to TValue when passed to equalTo.
+            return equalTo<TValue>(std::forward<TExpected>(value));
+        }
+};
+
+}
+}
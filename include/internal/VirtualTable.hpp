@@ -1,6 +1,6 @@
 #pragma once
 
-#include <functional>
+#include <algorithm>
 #include <memory>
 
 #include <internal/UnknownCall.hpp>
@@ -16,11 +16,47 @@ namespace Internal {
 template <typename TInterface>
 class VirtualTable {
     private:
+        /// A virtual table where every method points to
+        /// UnknownCall::onUnknownCall, which is created once per interface and
+        /// copied into every VirtualTable.
+        struct Prototype {
+            /// The size of the virtual table.
+            VirtualTableSize virtualTableSize;
+
+            /// The raw virtual table.
+            std::unique_ptr<void*[]> virtualTable;
+
+            /// Creates a Prototype by looking up the size of the interface's
+            /// virtual table.
+            Prototype()
+                : virtualTableSize(VirtualTableOffsetContext
+                    ::getVirtualTableSize<TInterface>())
+                , virtualTable(new void*[virtualTableSize]) {
+                // Fill the virtual table with pointers to
+                // UnknownCall::onUnknownCall.
+                std::fill(
+                    virtualTable.get(),
+                    virtualTable.get() + virtualTableSize,
+                    reinterpret_cast<void*>(UnknownCall::onUnknownCall));
+            }
+        };
+
+        /// Gets the Prototype of the interface.
+        ///
+        /// @return A reference to the Prototype.
+        static const Prototype& getPrototype() {
+            // Create the Prototype the first time it is needed.
+            static const Prototype prototype;
+
+            // Return the Prototype.
+            return prototype;
+        }
+
         // The size of the virtual table.
         VirtualTableSize _virtualTableSize;
 
         // A pointer to the raw virtual table.
-        std::unique_ptr<void*, std::function<void(void**)>> _virtualTable;
+        std::unique_ptr<void*[]> _virtualTable;
 
     public:
         /// Creates a VirtualTable.
@@ -28,19 +64,13 @@ class VirtualTable {
         /// All methods will initially point to a method throwing an exception
         /// explaining that the method in question has not been mocked.
         VirtualTable()
-            : _virtualTableSize(VirtualTableOffsetContext
-                ::getVirtualTableSize<TInterface>())
-            , _virtualTable(
-                new void*[_virtualTableSize],
-                [](void** virtualTable) {
-                    delete[] virtualTable;
-                }) {
-            // Fill the virtual table with pointers to
-            // UnknownCall::onUnknownCall.
-            std::fill(
-                _virtualTable.get(),
-                _virtualTable.get() + _virtualTableSize,
-                reinterpret_cast<void*>(UnknownCall::onUnknownCall));
+            : _virtualTableSize(getPrototype().virtualTableSize)
+            , _virtualTable(new void*[_virtualTableSize]) {
+            // Copy the virtual table from the Prototype.
+            std::copy(
+                getPrototype().virtualTable.get(),
+                getPrototype().virtualTable.get() + _virtualTableSize,
+                _virtualTable.get());
         }
 
         /// Gets the raw virtual table.
@@ -50,6 +80,14 @@ class VirtualTable {
             // Return the raw virtual table.
             return _virtualTable.get();
         }
+
+        /// Gets the number of methods in the virtual table.
+        ///
+        /// @return The size of the virtual table.
+        VirtualTableSize getSize() const {
+            // Return the size of the virtual table.
+            return _virtualTableSize;
+        }
 };
 
 }
@@ -1,9 +1,34 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <exception/NonVirtualMethodException.hpp>
 #include <internal/VirtualTableOffset.hpp>
-#include <internal/VirtualTableOffsetReference.hpp>
 #include <Method.hpp>
 
+// Decide how virtual table offsets are looked up. Platforms using the Itanium
+// C++ ABI, which GCC and Clang use on x86 and ARM unless Clang targets the
+// Microsoft ABI, store the offset in the method pointer, where it is read
+// directly. Other platforms call the method on a VirtualTableOffsetReference,
+// which can also be chosen on any platform by defining
+// IMOCK_VIRTUAL_TABLE_OFFSET_REFERENCE.
+#if !defined(IMOCK_VIRTUAL_TABLE_OFFSET_REFERENCE) \
+    && defined(__GNUC__) \
+    && !defined(_MSC_VER) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define IMOCK_ITANIUM_METHOD_POINTERS
+#elif !defined(IMOCK_VIRTUAL_TABLE_OFFSET_REFERENCE) \
+    && defined(__GNUC__) \
+    && !defined(_MSC_VER) \
+    && (defined(__aarch64__) || defined(__arm__))
+#define IMOCK_ITANIUM_METHOD_POINTERS
+#define IMOCK_ARM_METHOD_POINTERS
+#else
+#include <internal/VirtualTableOffsetReference.hpp>
+#endif
+
 namespace IMock {
 namespace Internal {
 
@@ -21,7 +46,32 @@ class VirtualTableOffsetContext {
                 virtual void lastMethod() = 0;
         };
 
+#if defined(IMOCK_ITANIUM_METHOD_POINTERS)
+        /// The representation of a method pointer in the Itanium C++ ABI.
+        struct ItaniumMethodPointer {
+            /// For virtual methods, the offset of the method in the virtual
+            /// table in bytes plus one, and otherwise the address of the
+            /// method, which is even. On ARM, the offset is stored without
+            /// adding one, and adjustment is odd instead.
+            std::uintptr_t pointer;
+
+            /// The adjustment of this when the method is called, which is
+            /// doubled on ARM.
+            std::ptrdiff_t adjustment;
+        };
+#endif
+
     public:
+        /// Whether virtual table offsets are read from method pointers, which
+        /// supports interfaces with any number of methods and detects methods
+        /// that are not virtual. Otherwise, interfaces can have at most 4096
+        /// methods.
+#if defined(IMOCK_ITANIUM_METHOD_POINTERS)
+        static const bool readsMethodPointers = true;
+#else
+        static const bool readsMethodPointers = false;
+#endif
+
         /// VirtualTableOffsetContext is not supposed to be instantiated since
         /// it only contains static methods.
         VirtualTableOffsetContext() = delete;
@@ -31,11 +81,42 @@ class VirtualTableOffsetContext {
         ///
         /// @param method The method to look up.
         /// @return The virtual table offset of the method.
+        /// @throws Throws a NonVirtualMethodException if the offset is read
+        /// from the method pointer and the method is not virtual.
         /// @tparam TInterface The type of interface to get the virtual table
         /// offset from.
         template <typename TInterface, typename TReturn, typename ...TArguments>
         static VirtualTableOffset getVirtualTableOffset(
             Method<TInterface, TReturn, TArguments...> method) {
+#if defined(IMOCK_ITANIUM_METHOD_POINTERS)
+            // Copy the representation of the method pointer.
+            static_assert(
+                sizeof(method) == sizeof(ItaniumMethodPointer),
+                "Method pointers must follow the Itanium C++ ABI.");
+            ItaniumMethodPointer methodPointer;
+            std::memcpy(&methodPointer, &method, sizeof(methodPointer));
+
+            // Check that the method is virtual, since the method pointer
+            // otherwise contains the address of the method.
+#if defined(IMOCK_ARM_METHOD_POINTERS)
+            bool isVirtual = (methodPointer.adjustment & 1) != 0;
+#else
+            bool isVirtual = (methodPointer.pointer & 1) != 0;
+#endif
+            if(!isVirtual) {
+                throw Exception::NonVirtualMethodException();
+            }
+
+            // Convert the offset in bytes to an offset in virtual table
+            // entries.
+#if defined(IMOCK_ARM_METHOD_POINTERS)
+            return static_cast<VirtualTableOffset>(
+                methodPointer.pointer / sizeof(void*));
+#else
+            return static_cast<VirtualTableOffset>(
+                (methodPointer.pointer - 1) / sizeof(void*));
+#endif
+#else
             // Declare a using for reference methods.
             using ReferenceMethod
                 = Method<VirtualTableOffsetReference, VirtualTableOffset>;
@@ -52,6 +133,55 @@ class VirtualTableOffsetContext {
             // Call the reference method, whose return value is its virtual
             // table offset.
             return (virtualTableOffsetReference.*referenceMethod)();
+#endif
+        }
+
+        /// Gets the offset in the virtual table of a provided constant method
+        /// in the interface.
+        ///
+        /// @param method The constant method to look up.
+        /// @return The virtual table offset of the constant method.
+        /// @throws Throws a NonVirtualMethodException if the offset is read
+        /// from the method pointer and the method is not virtual.
+        /// @tparam TInterface The type of interface to get the virtual table
+        /// offset from.
+        template <typename TInterface, typename TReturn, typename ...TArguments>
+        static VirtualTableOffset getVirtualTableOffset(
+            TReturn (TInterface::*method)(TArguments...) const) {
+            // Cast the constant method to a regular method, which has the same
+            // representation, and forward the call to the regular
+            // getVirtualTableOffset.
+            return getVirtualTableOffset(
+                reinterpret_cast<Method<TInterface, TReturn, TArguments...>>(
+                    method));
+        }
+
+        /// Gets the offset in the virtual table of a method provided as a
+        /// template argument.
+        ///
+        /// When the offset is read from the method pointer, the compiler can
+        /// do so at compile time. Otherwise, the offset is only calculated the
+        /// first time the method is called for a certain method, making
+        /// subsequent calls cheap.
+        ///
+        /// @return The virtual table offset of the method.
+        /// @throws Throws a NonVirtualMethodException if the offset is read
+        /// from the method pointer and the method is not virtual.
+        /// @tparam TMethod The type of the method.
+        /// @tparam method The method to look up.
+        template <typename TMethod, TMethod method>
+        static VirtualTableOffset getVirtualTableOffset() {
+#if defined(IMOCK_ITANIUM_METHOD_POINTERS)
+            // Read the offset from the method pointer.
+            return getVirtualTableOffset(method);
+#else
+            // Calculate the offset once and store it.
+            static const VirtualTableOffset virtualTableOffset
+                = getVirtualTableOffset(method);
+
+            // Return the stored offset.
+            return virtualTableOffset;
+#endif
         }
 
         /// Gets the size of the virtual table of an interface.
@@ -73,3 +203,7 @@ class VirtualTableOffsetContext {
 
 }
 }
+
+// Undefine the used macros.
+#undef IMOCK_ITANIUM_METHOD_POINTERS
+#undef IMOCK_ARM_METHOD_POINTERS
@@ -7,6 +7,7 @@
 /// Call this with a Mock and a method on the mocked interface to get a
 /// MockWithMethod to use to add a mock case.
 #define when(mock, method) \
-    mock.withCounter<__COUNTER__>().withMethod( \
-        &mockType(mock)::method, \
+    mock.withCounter<__COUNTER__>().withMethod< \
+        decltype(&mockType(mock)::method), \
+        &mockType(mock)::method>( \
         #mock ".get()." #method)
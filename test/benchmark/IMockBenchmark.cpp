@@ -0,0 +1,265 @@
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <IMock.hpp>
+
+/// An interface with methods of increasing arity.
+class IArity {
+    public:
+        virtual int arity0() = 0;
+        virtual int arity1(int) = 0;
+        virtual int arity2(int, int) = 0;
+        virtual int arity4(int, int, int, int) = 0;
+        virtual int arity8(int, int, int, int, int, int, int, int) = 0;
+};
+
+/// An interface taking arguments in different ways.
+class IArguments {
+    public:
+        virtual int byValue(std::string) = 0;
+        virtual int byReference(const std::string&) = 0;
+        virtual int byMove(std::unique_ptr<int>) = 0;
+};
+
+/// An interface with a single method.
+class IIdentity {
+    public:
+        virtual int id(int) = 0;
+};
+
+TEST_CASE("dispatch by arity", "[dispatch]") {
+    // Mock every method with a mock case for specific arguments.
+    IMock::Mock<IArity> mock;
+    when(mock, arity0)
+        .with()
+        .returns(0);
+    when(mock, arity1)
+        .with(1)
+        .returns(1);
+    when(mock, arity2)
+        .with(1, 2)
+        .returns(2);
+    when(mock, arity4)
+        .with(1, 2, 3, 4)
+        .returns(4);
+    when(mock, arity8)
+        .with(1, 2, 3, 4, 5, 6, 7, 8)
+        .returns(8);
+
+    // Measure calls with the mocked arguments.
+    BENCHMARK("0 arguments") {
+        return mock.get().arity0();
+    };
+    BENCHMARK("1 argument") {
+        return mock.get().arity1(1);
+    };
+    BENCHMARK("2 arguments") {
+        return mock.get().arity2(1, 2);
+    };
+    BENCHMARK("4 arguments") {
+        return mock.get().arity4(1, 2, 3, 4);
+    };
+    BENCHMARK("8 arguments") {
+        return mock.get().arity8(1, 2, 3, 4, 5, 6, 7, 8);
+    };
+}
+
+TEST_CASE("dispatch by argument type", "[dispatch]") {
+    // Mock every method with a fake, which works for arguments of any type.
+    IMock::Mock<IArguments> mock;
+    when(mock, byValue).fake([](std::string value) {
+        return static_cast<int>(value.size());
+    });
+    when(mock, byReference).fake([](const std::string& value) {
+        return static_cast<int>(value.size());
+    });
+    when(mock, byMove).fake([](std::unique_ptr<int> value) {
+        return value ? 1 : 0;
+    });
+
+    // Measure calls passing a string short enough not to allocate memory when
+    // copied, and an empty pointer that is moved.
+    std::string value = "value";
+    BENCHMARK("value") {
+        return mock.get().byValue(value);
+    };
+    BENCHMARK("reference") {
+        return mock.get().byReference(value);
+    };
+    BENCHMARK("move-only") {
+        return mock.get().byMove(std::unique_ptr<int>());
+    };
+}
+
+TEST_CASE("dispatch by number of mock cases", "[dispatch]") {
+    // Declare a macro for benchmark cases with the provided number of mock
+    // cases. Calls alternate between the two oldest mock cases, which makes
+    // every call search the mock cases. Mock cases for specific arguments are
+    // found in constant time, while mock cases with matchers are scanned.
+    #define benchmarkMockCaseCount(mockCaseCount) \
+    { \
+        IMock::Mock<IIdentity> indexedMock; \
+        IMock::Mock<IIdentity> scannedMock; \
+        for(int i = 0; i < mockCaseCount; i++) { \
+            when(indexedMock, id) \
+                .with(i) \
+                .returns(i); \
+            when(scannedMock, id) \
+                .with(IMock::equalTo(i)) \
+                .returns(i); \
+        } \
+        int argument = 0; \
+        BENCHMARK(#mockCaseCount " indexed mock cases") { \
+            argument = (argument + 1) % 2; \
+            return indexedMock.get().id(argument); \
+        }; \
+        BENCHMARK(#mockCaseCount " mock cases with matchers") { \
+            argument = (argument + 1) % 2; \
+            return scannedMock.get().id(argument); \
+        }; \
+    }
+
+    // Create benchmark cases for numbers of mock cases that grow by a factor
+    // of sixteen.
+    benchmarkMockCaseCount(2)
+    benchmarkMockCaseCount(32)
+    benchmarkMockCaseCount(512)
+    benchmarkMockCaseCount(8192)
+
+    // Remove the macro since it is only used here.
+    #undef benchmarkMockCaseCount
+}
+
+TEST_CASE("dispatch of hits and misses", "[dispatch]") {
+    // Create a Mock of IIdentity with a number of mock cases for specific
+    // arguments and a Mock with a fake matching every call.
+    IMock::Mock<IIdentity> mock;
+    for(int i = 0; i < 1024; i++) {
+        when(mock, id)
+            .with(i)
+            .returns(i);
+    }
+    IMock::Mock<IIdentity> fakeMock;
+    when(fakeMock, id).fake([](int value) {
+        return value;
+    });
+
+    // Measure calls handled without searching the mock cases.
+    BENCHMARK("hit of a mock case matching every call") {
+        return fakeMock.get().id(1);
+    };
+    BENCHMARK("hit of the previously matched mock case") {
+        return mock.get().id(1);
+    };
+
+    // Measure calls searching the mock cases by alternating the arguments.
+    int argument = 0;
+    BENCHMARK("miss") {
+        argument = (argument + 1) % 2;
+        return mock.get().id(argument);
+    };
+
+    // Measure calls not matching any mock case, which throw.
+    BENCHMARK("unmatched call") {
+        try {
+            return mock.get().id(-1);
+        }
+        catch(const IMock::Exception::UnmockedCallException&) {
+            return 0;
+        }
+    };
+}
+
+TEST_CASE("construction and destruction", "[construction]") {
+    // Measure creating an empty Mock.
+    BENCHMARK_ADVANCED("construct an empty Mock")(
+        Catch::Benchmark::Chronometer meter) {
+        std::vector<Catch::Benchmark::storage_for<IMock::Mock<IArity>>>
+            storage(meter.runs());
+        meter.measure([&](int i) {
+            storage[i].construct();
+        });
+    };
+
+    // Measure destroying a Mock with a number of mock cases, including
+    // releasing the memory of the Mock itself.
+    BENCHMARK_ADVANCED("destroy a Mock with 16 mock cases")(
+        Catch::Benchmark::Chronometer meter) {
+        std::vector<std::unique_ptr<IMock::Mock<IIdentity>>> mocks;
+        for(int run = 0; run < meter.runs(); run++) {
+            mocks.emplace_back(new IMock::Mock<IIdentity>());
+            IMock::Mock<IIdentity>& mock = *mocks.back();
+            for(int i = 0; i < 16; i++) {
+                when(mock, id)
+                    .with(i)
+                    .returns(i);
+            }
+        }
+        meter.measure([&](int i) {
+            mocks[i].reset();
+        });
+    };
+
+    // Measure the whole life of a Mock with a mock case, from creation to
+    // destruction.
+    BENCHMARK("create, mock, call and destroy a Mock") {
+        IMock::Mock<IIdentity> mock;
+        when(mock, id)
+            .with(0)
+            .returns(0);
+        return mock.get().id(0);
+    };
+
+    // Measure the same with a Mock reused from a MockPool.
+    IMock::MockPool<IIdentity> pool;
+    BENCHMARK("acquire, mock, call and release a pooled Mock") {
+        IMock::PooledMock<IIdentity> pooledMock = pool.acquire();
+        IMock::Mock<IIdentity>& mock = pooledMock.getMock();
+        when(mock, id)
+            .with(0)
+            .returns(0);
+        return mock.get().id(0);
+    };
+}
+
+TEST_CASE("bulk setup", "[setup]") {
+    // Declare a macro for benchmark cases adding the provided number of mock
+    // cases, one by one and as a table.
+    #define benchmarkSetup(mockCaseCount) \
+    { \
+        std::vector<std::pair<std::tuple<int>, int>> entries; \
+        for(int i = 0; i < mockCaseCount; i++) { \
+            entries.emplace_back(std::make_tuple(i), i); \
+        } \
+        BENCHMARK(#mockCaseCount " mock cases with with() and returns()") { \
+            IMock::Mock<IIdentity> mock; \
+            for(int i = 0; i < mockCaseCount; i++) { \
+                when(mock, id) \
+                    .with(i) \
+                    .returns(i); \
+            } \
+            return mock.get().id(0); \
+        }; \
+        BENCHMARK(#mockCaseCount " mock cases with table()") { \
+            IMock::Mock<IIdentity> mock; \
+            when(mock, id).table(entries); \
+            return mock.get().id(0); \
+        }; \
+    }
+
+    // Create benchmark cases for numbers of mock cases that grow by a factor
+    // of sixteen.
+    benchmarkSetup(16)
+    benchmarkSetup(256)
+    benchmarkSetup(4096)
+    benchmarkSetup(65536)
+
+    // Remove the macro since it is only used here.
+    #undef benchmarkSetup
+}
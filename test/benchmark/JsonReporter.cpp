@@ -0,0 +1,169 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+/// A Catch reporter writing the results of the benchmarks as JSON, which is
+/// selected with "--reporter json".
+///
+/// Every benchmark is written with the name of its test case and its own name,
+/// which together identify it across runs, followed by the mean and the
+/// standard deviation with the confidence intervals computed by Catch. Every
+/// duration is in nanoseconds per iteration.
+class JsonReporter : public Catch::StreamingReporterBase<JsonReporter> {
+    private:
+        /// The benchmarks that have ended, already written as JSON objects.
+        std::vector<std::string> _benchmarks;
+
+        /// Writes a string as a JSON string.
+        ///
+        /// @param stream The stream to write to.
+        /// @param value The string to write.
+        static void writeString(
+            std::ostream& stream,
+            const std::string& value) {
+            // Write the characters, escaping the ones JSON requires to be
+            // escaped.
+            stream << '"';
+            for(char character : value) {
+                switch(character) {
+                    case '"':
+                        stream << "\\\"";
+                        break;
+                    case '\\':
+                        stream << "\\\\";
+                        break;
+                    case '\n':
+                        stream << "\\n";
+                        break;
+                    case '\t':
+                        stream << "\\t";
+                        break;
+                    default:
+                        if(static_cast<unsigned char>(character) < 0x20) {
+                            char escaped[7];
+                            std::snprintf(
+                                escaped,
+                                sizeof(escaped),
+                                "\\u%04x",
+                                static_cast<unsigned int>(character));
+                            stream << escaped;
+                        }
+                        else {
+                            stream << character;
+                        }
+                }
+            }
+            stream << '"';
+        }
+
+        /// Writes a number as a JSON number, or as null if it isn't finite.
+        ///
+        /// @param stream The stream to write to.
+        /// @param value The number to write.
+        static void writeNumber(std::ostream& stream, double value) {
+            // JSON has no representation of infinities and NaN.
+            if(std::isfinite(value)) {
+                stream << value;
+            }
+            else {
+                stream << "null";
+            }
+        }
+
+        /// Writes an estimate computed by Catch as a JSON object.
+        ///
+        /// @param stream The stream to write to.
+        /// @param estimate The estimate to write.
+        static void writeEstimate(
+            std::ostream& stream,
+            const Catch::Benchmark::Estimate<
+                Catch::Benchmark::FloatDuration<
+                    Catch::Benchmark::default_clock>>& estimate) {
+            // Write the point estimate and its confidence interval.
+            stream << "{\"point\": ";
+            writeNumber(stream, estimate.point.count());
+            stream << ", \"lowerBound\": ";
+            writeNumber(stream, estimate.lower_bound.count());
+            stream << ", \"upperBound\": ";
+            writeNumber(stream, estimate.upper_bound.count());
+            stream << ", \"confidenceInterval\": ";
+            writeNumber(stream, estimate.confidence_interval);
+            stream << "}";
+        }
+
+    public:
+        /// Creates a JsonReporter.
+        ///
+        /// @param config The configuration of the reporter.
+        JsonReporter(const Catch::ReporterConfig& config)
+            : StreamingReporterBase(config) {
+        }
+
+        /// Describes the reporter when the reporters are listed.
+        ///
+        /// @return The description.
+        static std::string getDescription() {
+            // Return the description.
+            return "Writes the results of benchmarks as JSON";
+        }
+
+        void assertionStarting(const Catch::AssertionInfo&) override {
+        }
+
+        bool assertionEnded(const Catch::AssertionStats&) override {
+            // Let Catch clear the messages of the assertion.
+            return true;
+        }
+
+        /// Writes a benchmark that has ended.
+        ///
+        /// @param stats The results of the benchmark.
+        void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override {
+            // Write the benchmark with the name of its test case.
+            std::ostringstream benchmark;
+            benchmark.precision(10);
+            benchmark << "    {\n      \"testCase\": ";
+            writeString(benchmark, currentTestCaseInfo->name);
+            benchmark << ",\n      \"name\": ";
+            writeString(benchmark, stats.info.name);
+            benchmark << ",\n      \"samples\": " << stats.info.samples;
+            benchmark << ",\n      \"iterations\": " << stats.info.iterations;
+            benchmark << ",\n      \"mean\": ";
+            writeEstimate(benchmark, stats.mean);
+            benchmark << ",\n      \"standardDeviation\": ";
+            writeEstimate(benchmark, stats.standardDeviation);
+            benchmark << ",\n      \"outlierVariance\": ";
+            writeNumber(benchmark, stats.outlierVariance);
+            benchmark << "\n    }";
+            _benchmarks.push_back(benchmark.str());
+        }
+
+        /// Writes the JSON document once every benchmark has ended.
+        ///
+        /// @param stats The results of the test run.
+        void testRunEnded(const Catch::TestRunStats& stats) override {
+            // Write the benchmarks together with the number of failed
+            // assertions, which tells if the results can be trusted.
+            stream << "{\n  \"unit\": \"nanoseconds\",\n";
+            stream << "  \"failedAssertions\": "
+                << stats.totals.assertions.failed << ",\n";
+            stream << "  \"benchmarks\": [";
+            for(std::size_t i = 0; i < _benchmarks.size(); i++) {
+                stream << (i == 0 ? "\n" : ",\n") << _benchmarks[i];
+            }
+            stream << "\n  ]\n}\n";
+
+            // Let the base class finish the test run.
+            StreamingReporterBase::testRunEnded(stats);
+        }
+};
+
+CATCH_REGISTER_REPORTER("json", JsonReporter)
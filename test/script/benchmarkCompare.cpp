@@ -0,0 +1,545 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::endl;
+using std::ifstream;
+using std::map;
+using std::shared_ptr;
+using std::string;
+using std::stringstream;
+using std::vector;
+
+/// The regression threshold in percent used if none is provided.
+const double defaultThreshold = 10;
+
+/// A class implementing std::exception that can be thrown by the program when
+/// deemed necessary.
+class Exception : public std::exception {
+    private:
+        /// An explanation of what went wrong.
+        string message;
+
+    public:
+        /// Creates an Exception.
+        ///
+        /// @param message An explanation of what went wrong.
+        Exception(string message);
+
+        /// An override of std::exception::what() that returns the message.
+        ///
+        /// @return A constant pointer to the message.
+        const char* what() const noexcept override;
+};
+
+Exception::Exception(
+    string message)
+    : message(message) {
+}
+
+const char* Exception::what() const noexcept {
+    // Return a constant pointer to the message.
+    return message.c_str();
+}
+
+/// A parsed JSON value.
+struct JsonValue {
+    /// The possible types of a JSON value.
+    enum class Type {
+        Null,
+        Boolean,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    /// The type of the value.
+    Type type;
+
+    /// The value if it is a boolean.
+    bool boolean;
+
+    /// The value if it is a number.
+    double number;
+
+    /// The value if it is a string.
+    string text;
+
+    /// The elements if the value is an array.
+    vector<shared_ptr<JsonValue>> elements;
+
+    /// The members if the value is an object.
+    map<string, shared_ptr<JsonValue>> members;
+
+    /// Creates a null JsonValue.
+    JsonValue()
+        : type(Type::Null)
+        , boolean(false)
+        , number(0) {
+    }
+
+    /// Gets a member of an object.
+    ///
+    /// @param name The name of the member.
+    /// @return The member.
+    /// @throws Throws an Exception if the value is not an object or does not
+    /// have the member.
+    const JsonValue& get(const string& name) const {
+        // Check that the value is an object with the member.
+        if(type != Type::Object || members.count(name) == 0) {
+            throw Exception("Missing JSON member " + name);
+        }
+
+        // Return the member.
+        return *members.at(name);
+    }
+
+    /// Gets the value as a number.
+    ///
+    /// @return The number, or NaN if the value is null.
+    /// @throws Throws an Exception if the value is neither a number nor null.
+    double getNumber() const {
+        // Null is written for numbers that are not finite.
+        if(type == Type::Null) {
+            return NAN;
+        }
+
+        // Check that the value is a number.
+        if(type != Type::Number) {
+            throw Exception("Expected a JSON number");
+        }
+
+        // Return the number.
+        return number;
+    }
+
+    /// Gets the value as a string.
+    ///
+    /// @return The string.
+    /// @throws Throws an Exception if the value is not a string.
+    const string& getString() const {
+        // Check that the value is a string.
+        if(type != Type::String) {
+            throw Exception("Expected a JSON string");
+        }
+
+        // Return the string.
+        return text;
+    }
+};
+
+/// Parses JSON text.
+class JsonParser {
+    private:
+        /// The text to parse.
+        const string& text;
+
+        /// The position of the next character to parse.
+        size_t position;
+
+        /// Skips any whitespaces.
+        void skipWhitespaces() {
+            // Move past every whitespace.
+            while(position < text.size()
+                && string(" \t\n\r").find(text[position]) != string::npos) {
+                position++;
+            }
+        }
+
+        /// Throws an Exception describing a syntax error at the current
+        /// position.
+        ///
+        /// @throws Throws an Exception.
+        void fail() const {
+            // Throw an Exception with the position.
+            stringstream message;
+            message << "Invalid JSON at character " << position;
+            throw Exception(message.str());
+        }
+
+        /// Checks that the text continues with the provided token and moves
+        /// past it.
+        ///
+        /// @param token The expected token.
+        /// @throws Throws an Exception if the text does not continue with the
+        /// token.
+        void expect(const string& token) {
+            // Check the token.
+            if(text.compare(position, token.size(), token) != 0) {
+                fail();
+            }
+
+            // Move past the token.
+            position += token.size();
+        }
+
+        /// Parses a string, starting at its opening quote.
+        ///
+        /// @return The string.
+        /// @throws Throws an Exception if the string is invalid.
+        string parseString() {
+            // Move past the opening quote.
+            expect("\"");
+
+            // Read characters until the closing quote.
+            string result;
+            while(position < text.size() && text[position] != '"') {
+                // Copy characters that are not escaped.
+                char character = text[position++];
+                if(character != '\\') {
+                    result += character;
+                    continue;
+                }
+
+                // Decode escaped characters.
+                if(position >= text.size()) {
+                    fail();
+                }
+                char escaped = text[position++];
+                switch(escaped) {
+                    case 'n':
+                        result += '\n';
+                        break;
+                    case 't':
+                        result += '\t';
+                        break;
+                    case 'r':
+                        result += '\r';
+                        break;
+                    case 'b':
+                        result += '\b';
+                        break;
+                    case 'f':
+                        result += '\f';
+                        break;
+                    case 'u': {
+                        // Decode code points below 128 and replace others
+                        // with a question mark, which is enough for names.
+                        if(position + 4 > text.size()) {
+                            fail();
+                        }
+                        unsigned long codePoint = std::stoul(
+                            text.substr(position, 4),
+                            nullptr,
+                            16);
+                        position += 4;
+                        result += codePoint < 128
+                            ? static_cast<char>(codePoint)
+                            : '?';
+                        break;
+                    }
+                    default:
+                        result += escaped;
+                }
+            }
+
+            // Move past the closing quote.
+            expect("\"");
+
+            // Return the string.
+            return result;
+        }
+
+        /// Parses a number.
+        ///
+        /// @return The number.
+        /// @throws Throws an Exception if the number is invalid.
+        double parseNumber() {
+            // Parse the number with strtod, which moves past it.
+            const char* start = text.c_str() + position;
+            char* end;
+            double number = std::strtod(start, &end);
+            if(end == start) {
+                fail();
+            }
+            position += end - start;
+
+            // Return the number.
+            return number;
+        }
+
+    public:
+        /// Creates a JsonParser.
+        ///
+        /// @param text The text to parse, which must outlive the JsonParser.
+        JsonParser(const string& text)
+            : text(text)
+            , position(0) {
+        }
+
+        /// Parses a value starting at the current position.
+        ///
+        /// @return The value.
+        /// @throws Throws an Exception if the value is invalid.
+        shared_ptr<JsonValue> parseValue() {
+            // Create a null value.
+            shared_ptr<JsonValue> value(new JsonValue());
+
+            // Decide the type of the value from its first character.
+            skipWhitespaces();
+            if(position >= text.size()) {
+                fail();
+            }
+            char first = text[position];
+            if(first == '{') {
+                // Parse the members of an object.
+                value->type = JsonValue::Type::Object;
+                position++;
+                skipWhitespaces();
+                if(position < text.size() && text[position] == '}') {
+                    position++;
+                    return value;
+                }
+                while(true) {
+                    skipWhitespaces();
+                    string name = parseString();
+                    skipWhitespaces();
+                    expect(":");
+                    value->members[name] = parseValue();
+                    skipWhitespaces();
+                    if(position < text.size() && text[position] == ',') {
+                        position++;
+                        continue;
+                    }
+                    expect("}");
+                    return value;
+                }
+            }
+            else if(first == '[') {
+                // Parse the elements of an array.
+                value->type = JsonValue::Type::Array;
+                position++;
+                skipWhitespaces();
+                if(position < text.size() && text[position] == ']') {
+                    position++;
+                    return value;
+                }
+                while(true) {
+                    value->elements.push_back(parseValue());
+                    skipWhitespaces();
+                    if(position < text.size() && text[position] == ',') {
+                        position++;
+                        continue;
+                    }
+                    expect("]");
+                    return value;
+                }
+            }
+            else if(first == '"') {
+                // Parse a string.
+                value->type = JsonValue::Type::String;
+                value->text = parseString();
+            }
+            else if(first == 't' || first == 'f') {
+                // Parse a boolean.
+                value->type = JsonValue::Type::Boolean;
+                value->boolean = first == 't';
+                expect(value->boolean ? "true" : "false");
+            }
+            else if(first == 'n') {
+                // Parse null.
+                expect("null");
+            }
+            else {
+                // Parse a number.
+                value->type = JsonValue::Type::Number;
+                value->number = parseNumber();
+            }
+
+            // Return the value.
+            return value;
+        }
+};
+
+/// The mean time of a benchmark together with its confidence interval.
+struct BenchmarkResult {
+    /// The estimated mean in nanoseconds.
+    double mean;
+
+    /// The lower bound of the confidence interval of the mean.
+    double lowerBound;
+
+    /// The upper bound of the confidence interval of the mean.
+    double upperBound;
+};
+
+/// Reads the benchmark results written by the json reporter of IMockBenchmark.
+///
+/// @param path The path to the JSON file.
+/// @return The results by "test case / benchmark" in the order of the names.
+/// @throws Throws an Exception if the file could not be read or parsed, or if
+/// any assertion failed during the benchmark run.
+map<string, BenchmarkResult> readResults(const string& path) {
+    // Read the file.
+    ifstream file(path);
+    if(!file.is_open()) {
+        throw Exception("Could not open the file at " + path);
+    }
+    stringstream content;
+    content << file.rdbuf();
+    string text = content.str();
+
+    // Parse the JSON.
+    JsonParser parser(text);
+    shared_ptr<JsonValue> document = parser.parseValue();
+
+    // Refuse results from runs where assertions failed.
+    if(document->get("failedAssertions").getNumber() != 0) {
+        throw Exception("Assertions failed during the benchmark run in "
+            + path);
+    }
+
+    // Get the mean of every benchmark.
+    map<string, BenchmarkResult> results;
+    const JsonValue& benchmarks = document->get("benchmarks");
+    for(const shared_ptr<JsonValue>& benchmark : benchmarks.elements) {
+        const JsonValue& mean = benchmark->get("mean");
+        results[benchmark->get("testCase").getString()
+            + " / "
+            + benchmark->get("name").getString()] = BenchmarkResult{
+                mean.get("point").getNumber(),
+                mean.get("lowerBound").getNumber(),
+                mean.get("upperBound").getNumber()
+            };
+    }
+
+    // Return the results.
+    return results;
+}
+
+/// Reads the benchmark results of several runs and keeps the run with the
+/// lowest mean for every benchmark, which filters out runs slowed down by other
+/// processes.
+///
+/// @param paths The paths to the JSON files separated by commas.
+/// @return The results by "test case / benchmark" in the order of the names.
+/// @throws Throws an Exception if any file could not be read or parsed.
+map<string, BenchmarkResult> readFastestResults(const string& paths) {
+    // Process every path.
+    map<string, BenchmarkResult> fastestResults;
+    stringstream pathStream(paths);
+    string path;
+    while(getline(pathStream, path, ',')) {
+        // Keep the results with lower means than the previous runs.
+        for(const auto& entry : readResults(path)) {
+            auto fastest = fastestResults.find(entry.first);
+            if(fastest == fastestResults.end()
+                || entry.second.mean < fastest->second.mean) {
+                fastestResults[entry.first] = entry.second;
+            }
+        }
+    }
+
+    // Return the fastest results.
+    return fastestResults;
+}
+
+/// Formats a number of nanoseconds with one decimal.
+///
+/// @param nanoseconds The number of nanoseconds.
+/// @return The formatted number.
+string formatNanoseconds(double nanoseconds) {
+    // Format the number.
+    char formatted[32];
+    std::snprintf(formatted, sizeof(formatted), "%.1f", nanoseconds);
+    return formatted;
+}
+
+/// The main method.
+///
+/// Compares the benchmark results in a file with the results in a baseline
+/// file. A benchmark has regressed if its mean has increased by more than the
+/// threshold and the confidence intervals of the means do not overlap, which
+/// keeps noise within a run from being reported as a regression.
+///
+/// Since the confidence intervals computed by Catch don't cover noise between
+/// runs, such as other processes using the same cores, several runs can be
+/// provided for the baseline and the results, separated by commas. The run
+/// with the lowest mean is used for every benchmark.
+///
+/// @param argc The number of arguments.
+/// @param argv The arguments, which are the paths to the baseline runs, the
+/// paths to the runs to compare with the baseline and optionally the threshold
+/// in percent.
+/// @return One if any benchmark has regressed and zero otherwise.
+/// @throws Throws an Exception if the number of arguments is less than three.
+int main(int argc, char** argv) {
+    // Check if the number of arguments is less than three.
+    if(argc < 3) {
+        // Throw an exception if the number of arguments is less than three.
+        throw Exception("Too few arguments. Usage: benchmarkCompare "
+            "<baseline.json[,...]> <current.json[,...]> "
+            "[threshold in percent]");
+    }
+
+    // Read the baseline and the current results.
+    map<string, BenchmarkResult> baseline = readFastestResults(argv[1]);
+    map<string, BenchmarkResult> current = readFastestResults(argv[2]);
+
+    // Get the threshold as a fraction.
+    double threshold = (argc > 3 ? std::stod(argv[3]) : defaultThreshold)
+        / 100;
+
+    // Compare every benchmark in the baseline.
+    int regressionCount = 0;
+    for(const auto& entry : baseline) {
+        // Report benchmarks that are no longer run.
+        const string& name = entry.first;
+        const BenchmarkResult& before = entry.second;
+        if(current.count(name) == 0) {
+            cout << "missing     " << name << endl;
+            continue;
+        }
+        const BenchmarkResult& after = current.at(name);
+
+        // Get the relative change of the mean.
+        double change = after.mean / before.mean - 1;
+
+        // Decide if the change is significant, which it is if the confidence
+        // intervals do not overlap and the change exceeds the threshold.
+        string status = "unchanged  ";
+        if(after.lowerBound > before.upperBound && change > threshold) {
+            status = "REGRESSED  ";
+            regressionCount++;
+        }
+        else if(after.upperBound < before.lowerBound && -change > threshold) {
+            status = "improved   ";
+        }
+
+        // Report the benchmark.
+        char formattedChange[32];
+        std::snprintf(
+            formattedChange,
+            sizeof(formattedChange),
+            "%+7.1f%%",
+            change * 100);
+        cout << status
+            << formattedChange << "  "
+            << formatNanoseconds(before.mean) << " ns -> "
+            << formatNanoseconds(after.mean) << " ns  "
+            << name << endl;
+    }
+
+    // Report benchmarks that are not in the baseline.
+    for(const auto& entry : current) {
+        if(baseline.count(entry.first) == 0) {
+            cout << "new         " << entry.first << endl;
+        }
+    }
+
+    // Summarize the comparison and fail if any benchmark has regressed.
+    cout << regressionCount << " of " << baseline.size()
+        << " benchmarks regressed by more than " << threshold * 100 << "%"
+        << endl;
+    return regressionCount > 0 ? 1 : 0;
+}
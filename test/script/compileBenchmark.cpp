@@ -0,0 +1,370 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+using std::cout;
+using std::endl;
+using std::ofstream;
+using std::string;
+using std::stringstream;
+using std::vector;
+
+/// The compiler command used if none is provided.
+const string defaultCompiler = "g++ -std=c++11";
+
+/// A class implementing std::exception that can be thrown by the program when
+/// deemed necessary.
+class Exception : public std::exception {
+    private:
+        /// An explanation of what went wrong.
+        string message;
+
+    public:
+        /// Creates an Exception.
+        ///
+        /// @param message An explanation of what went wrong.
+        Exception(string message);
+
+        /// An override of std::exception::what() that returns the message.
+        ///
+        /// @return A constant pointer to the message.
+        const char* what() const noexcept override;
+};
+
+Exception::Exception(
+    string message)
+    : message(message) {
+}
+
+const char* Exception::what() const noexcept {
+    // Return a constant pointer to the message.
+    return message.c_str();
+}
+
+/// Describes the size of a generated translation unit.
+struct Configuration {
+    /// The number of interfaces.
+    int interfaces;
+
+    /// The number of methods per interface.
+    int methods;
+
+    /// The number of calls to when per method.
+    int whenCallSites;
+};
+
+/// The cost of compiling a generated translation unit.
+struct Measurement {
+    /// The time the compilation took in seconds.
+    double seconds;
+
+    /// The peak memory used by the compiler in kilobytes.
+    long peakMemoryKilobytes;
+
+    /// The size of the object file in bytes.
+    long objectBytes;
+};
+
+/// Parses a configuration written as interfaces x methods x when call sites,
+/// such as 4x8x16.
+///
+/// @param text The text to parse.
+/// @return The configuration.
+/// @throws Throws an Exception if the text is not a configuration.
+Configuration parseConfiguration(const string& text) {
+    // Parse the three numbers.
+    Configuration configuration;
+    char separator1;
+    char separator2;
+    stringstream stream(text);
+    stream
+        >> configuration.interfaces
+        >> separator1
+        >> configuration.methods
+        >> separator2
+        >> configuration.whenCallSites;
+    if(stream.fail()
+        || !stream.eof()
+        || separator1 != 'x'
+        || separator2 != 'x'
+        || configuration.interfaces < 0
+        || configuration.methods < 0
+        || configuration.whenCallSites < 0) {
+        throw Exception("Invalid configuration " + text
+            + ", expected interfaces x methods x when call sites such as "
+            + "4x8x16");
+    }
+
+    // Return the configuration.
+    return configuration;
+}
+
+/// Generates a translation unit mocking interfaces, which instantiates the
+/// templates of IMock once per call to when.
+///
+/// @param configuration The size of the translation unit.
+/// @return The source code of the translation unit.
+string generateSource(const Configuration& configuration) {
+    // Include IMock.
+    stringstream source;
+    source << "#include <IMock.hpp>\n";
+
+    // Declare the interfaces.
+    for(int interface = 0; interface < configuration.interfaces; interface++) {
+        source << "\nclass IInterface" << interface << " {\n"
+            << "    public:\n";
+        for(int method = 0; method < configuration.methods; method++) {
+            source << "        virtual int method" << method
+                << "(int, const char*) = 0;\n";
+        }
+        source << "};\n";
+    }
+
+    // Mock every method of every interface in a function per interface, with
+    // the provided number of calls to when per method.
+    for(int interface = 0; interface < configuration.interfaces; interface++) {
+        source << "\nint mockInterface" << interface << "() {\n"
+            << "    IMock::Mock<IInterface" << interface << "> mock;\n"
+            << "    int result = 0;\n";
+        for(int method = 0; method < configuration.methods; method++) {
+            for(int call = 0; call < configuration.whenCallSites; call++) {
+                source << "    when(mock, method" << method << ")"
+                    << ".with(" << call << ", \"\")"
+                    << ".returns(" << call << ");\n";
+            }
+            source << "    result += mock.get().method" << method
+                << "(0, \"\");\n";
+        }
+        source << "    return result;\n"
+            << "}\n";
+    }
+
+    // Return the source code.
+    return source.str();
+}
+
+/// Writes a file.
+///
+/// @param path The path to the file to be written.
+/// @param content The content to write to the file.
+/// @throws Throws an Exception if a file handle could not be created.
+void writeFile(const string& path, const string& content) {
+    // Create an ofstream for the file.
+    ofstream file(path);
+
+    // Check if the file is open.
+    if(!file.is_open()) {
+        // Throw an exception if a file handle could not be created.
+        throw Exception("Could not create a file handle for " + path);
+    }
+
+    // Write the content.
+    file << content;
+}
+
+/// Runs a command with the shell and measures it.
+///
+/// @param command The command to run.
+/// @param seconds Set to the time the command took in seconds.
+/// @param peakMemoryKilobytes Set to the peak memory used by the command and
+/// the processes it waited for, in kilobytes on Linux and in bytes on macOS.
+/// @throws Throws an Exception if the command could not be run or failed.
+void runCommand(
+    const string& command,
+    double& seconds,
+    long& peakMemoryKilobytes) {
+    // Start the command in a child process.
+    steady_clock::time_point start = steady_clock::now();
+    pid_t child = fork();
+    if(child < 0) {
+        throw Exception("Could not start " + command);
+    }
+    if(child == 0) {
+        execl("/bin/sh", "sh", "-c", command.c_str(), (char*) nullptr);
+        _exit(127);
+    }
+
+    // Wait for the command, which also gets the resources it used.
+    int status;
+    struct rusage usage;
+    if(wait4(child, &status, 0, &usage) != child) {
+        throw Exception("Could not wait for " + command);
+    }
+    seconds = duration<double>(steady_clock::now() - start).count();
+    peakMemoryKilobytes = usage.ru_maxrss;
+
+    // Check that the command succeeded.
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        throw Exception("The command failed: " + command);
+    }
+}
+
+/// Generates and compiles a translation unit.
+///
+/// @param configuration The size of the translation unit.
+/// @param compiler The compiler command.
+/// @param includePath The path to the folder containing IMock.hpp.
+/// @param outputPath The folder to write the translation unit and the object
+/// file to.
+/// @return The cost of compiling the translation unit.
+/// @throws Throws an Exception if the compilation failed.
+Measurement measure(
+    const Configuration& configuration,
+    const string& compiler,
+    const string& includePath,
+    const string& outputPath) {
+    // Write the translation unit.
+    stringstream name;
+    name << outputPath << "/compileBenchmark"
+        << configuration.interfaces << "x"
+        << configuration.methods << "x"
+        << configuration.whenCallSites;
+    string sourcePath = name.str() + ".cpp";
+    string objectPath = name.str() + ".o";
+    writeFile(sourcePath, generateSource(configuration));
+
+    // Compile it.
+    Measurement measurement;
+    runCommand(
+        compiler + " -I" + includePath + " -c " + sourcePath
+            + " -o " + objectPath,
+        measurement.seconds,
+        measurement.peakMemoryKilobytes);
+
+    // Get the size of the object file.
+    struct stat objectStat;
+    if(stat(objectPath.c_str(), &objectStat) != 0) {
+        throw Exception("Could not find " + objectPath);
+    }
+    measurement.objectBytes = objectStat.st_size;
+
+    // Return the measurement.
+    return measurement;
+}
+
+/// Writes a string as a JSON string.
+///
+/// @param stream The stream to write to.
+/// @param value The string to write, which may contain quotes and
+/// backslashes.
+void writeJsonString(std::ostream& stream, const string& value) {
+    // Write the characters, escaping quotes and backslashes.
+    stream << '"';
+    for(char character : value) {
+        if(character == '"' || character == '\\') {
+            stream << '\\';
+        }
+        stream << character;
+    }
+    stream << '"';
+}
+
+/// The main method.
+///
+/// Generates translation units mocking a number of interfaces with a number
+/// of methods and calls to when per method, compiles them and writes the
+/// compile time, the peak memory used by the compiler and the size of the
+/// object file of each to a JSON file. A translation unit only including IMock
+/// is always measured first, which shows the cost of the headers themselves.
+///
+/// @param argc The number of arguments.
+/// @param argv The arguments, which are the path to the folder containing
+/// IMock.hpp, the path to the JSON file to write, optionally the compiler
+/// command and optionally the configurations to measure, written as
+/// interfaces x methods x when call sites such as 4x8x16.
+/// @return Zero.
+/// @throws Throws an Exception if the number of arguments is less than three
+/// or if a compilation failed.
+int main(int argc, char** argv) {
+    // Check if the number of arguments is less than three.
+    if(argc < 3) {
+        // Throw an exception if the number of arguments is less than three.
+        throw Exception("Too few arguments. Usage: compileBenchmark "
+            "<include folder> <output.json> [compiler] [configurations...]");
+    }
+
+    // Get the paths and the compiler.
+    string includePath = argv[1];
+    string jsonPath = argv[2];
+    string compiler = argc > 3 && string(argv[3]) != ""
+        ? argv[3]
+        : defaultCompiler;
+
+    // Get the configurations, starting with the headers only.
+    vector<Configuration> configurations = {Configuration{0, 0, 0}};
+    if(argc > 4) {
+        for(int argument = 4; argument < argc; argument++) {
+            configurations.push_back(parseConfiguration(argv[argument]));
+        }
+    }
+    else {
+        configurations.push_back(Configuration{1, 1, 1});
+        configurations.push_back(Configuration{1, 8, 1});
+        configurations.push_back(Configuration{1, 8, 8});
+        configurations.push_back(Configuration{8, 8, 1});
+        configurations.push_back(Configuration{8, 8, 8});
+    }
+
+    // Put the generated files next to the JSON file.
+    string::size_type lastSlash = jsonPath.find_last_of('/');
+    string outputPath = lastSlash == string::npos
+        ? "."
+        : jsonPath.substr(0, lastSlash);
+
+    // Measure every configuration and write the results.
+    stringstream json;
+    json << "{\n  \"compiler\": ";
+    writeJsonString(json, compiler);
+    json << ",\n  \"results\": [";
+    for(size_t i = 0; i < configurations.size(); i++) {
+        // Measure the configuration.
+        const Configuration& configuration = configurations[i];
+        Measurement measurement = measure(
+            configuration,
+            compiler,
+            includePath,
+            outputPath);
+
+        // Report the measurement.
+        char line[160];
+        std::snprintf(
+            line,
+            sizeof(line),
+            "%3d interfaces x %3d methods x %3d when: "
+            "%7.2f s, %8ld KB peak, %9ld bytes",
+            configuration.interfaces,
+            configuration.methods,
+            configuration.whenCallSites,
+            measurement.seconds,
+            measurement.peakMemoryKilobytes,
+            measurement.objectBytes);
+        cout << line << endl;
+
+        // Add the measurement to the JSON.
+        json << (i == 0 ? "\n" : ",\n")
+            << "    {\"interfaces\": " << configuration.interfaces
+            << ", \"methods\": " << configuration.methods
+            << ", \"whenCallSites\": " << configuration.whenCallSites
+            << ", \"compileSeconds\": " << measurement.seconds
+            << ", \"peakMemoryKilobytes\": "
+            << measurement.peakMemoryKilobytes
+            << ", \"objectBytes\": " << measurement.objectBytes << "}";
+    }
+    json << "\n  ]\n}\n";
+    writeFile(jsonPath, json.str());
+
+    // Return zero.
+    return 0;
+}
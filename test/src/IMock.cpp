@@ -1,3 +1,15 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #define CATCH_CONFIG_ENABLE_BENCHMARKING
@@ -5,6 +17,38 @@
 
 #include <IMock.hpp>
 
+/// The number of times memory has been allocated using operator new, which is
+/// atomic since some tests allocate memory from several threads.
+static std::atomic<std::size_t> allocationCount(0);
+
+/// Replaces the global operator new to count allocations.
+///
+/// @param size The number of bytes to allocate.
+/// @return A pointer to the allocated memory.
+void* operator new(std::size_t size) {
+    // Count the allocation.
+    allocationCount++;
+
+    // Allocate the memory using malloc.
+    void* memory = std::malloc(size == 0 ? 1 : size);
+
+    // Throw a bad_alloc if the allocation failed.
+    if(memory == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    // Return the allocated memory.
+    return memory;
+}
+
+/// Replaces the global operator delete to match the replaced operator new.
+///
+/// @param memory The memory to deallocate.
+void operator delete(void* memory) noexcept {
+    // Deallocate the memory using free.
+    std::free(memory);
+}
+
 /// An interface representing a calculator.
 class ICalculator {
     public:
@@ -1175,12 +1219,1885 @@ TEST_CASE("can mock an interface in a secondary file") {
     REQUIRE_NOTHROW(mockSecondaryFile());
 }
 
+/// An interface with a virtual destructor, which takes up entries in the
+/// virtual table before the methods.
+class IBase {
+    public:
+        virtual ~IBase() {
+        }
+
+        virtual int base(int) = 0;
+};
+
+/// An interface inheriting IBase, whose methods come after the destructor and
+/// the methods of IBase in the virtual table.
+class IDerived : public IBase {
+    public:
+        virtual int first(int) = 0;
+        virtual int second(int) const = 0;
+};
+
+TEST_CASE("can mock an interface inheriting another interface",
+    "[virtual_table]") {
+    // Create a Mock of IDerived and mock its methods with different values.
+    IMock::Mock<IDerived> mock;
+    when(mock, first)
+        .with(1)
+        .returns(20);
+    when(mock, second)
+        .with(1)
+        .returns(30);
+
+    // Verify every call reaches the mock case of its own method.
+    REQUIRE(mock.get().first(1) == 20);
+    REQUIRE(mock.get().second(1) == 30);
+
+    // Verify the method of IBase is not mocked.
+    REQUIRE_THROWS_AS(
+        mock.get().base(1),
+        IMock::Exception::UnknownCallException);
+}
+
+/// An interface with a method that is not virtual.
+class IWithNonVirtualMethod {
+    public:
+        virtual int mocked(int) = 0;
+
+        int notVirtual(int) {
+            return 0;
+        }
+};
+
+TEST_CASE("methods that are not virtual can't be mocked", "[virtual_table]") {
+    // Only check the method when offsets are read from method pointers, since
+    // the method can't be told apart from a virtual method otherwise.
+    if(!IMock::Internal::VirtualTableOffsetContext::readsMethodPointers) {
+        return;
+    }
+
+    // Create a Mock of IWithNonVirtualMethod.
+    IMock::Mock<IWithNonVirtualMethod> mock;
+
+    // Verify the method that is not virtual can't be mocked.
+    auto mockNotVirtual = [&]() {
+        when(mock, notVirtual)
+            .with(1)
+            .returns(1);
+    };
+    REQUIRE_THROWS_AS(
+        mockNotVirtual(),
+        IMock::Exception::NonVirtualMethodException);
+
+    // Verify the virtual method can still be mocked.
+    when(mock, mocked)
+        .with(1)
+        .returns(2);
+    REQUIRE(mock.get().mocked(1) == 2);
+}
+
+// Declare 5000 methods named method0000 to method4999, which is more than the
+// 4096 methods of VirtualTableOffsetReference.
+#define IMOCK_TEST_METHODS_10(prefix) \
+    virtual int prefix##0() = 0; \
+    virtual int prefix##1() = 0; \
+    virtual int prefix##2() = 0; \
+    virtual int prefix##3() = 0; \
+    virtual int prefix##4() = 0; \
+    virtual int prefix##5() = 0; \
+    virtual int prefix##6() = 0; \
+    virtual int prefix##7() = 0; \
+    virtual int prefix##8() = 0; \
+    virtual int prefix##9() = 0;
+#define IMOCK_TEST_METHODS_100(prefix) \
+    IMOCK_TEST_METHODS_10(prefix##0) \
+    IMOCK_TEST_METHODS_10(prefix##1) \
+    IMOCK_TEST_METHODS_10(prefix##2) \
+    IMOCK_TEST_METHODS_10(prefix##3) \
+    IMOCK_TEST_METHODS_10(prefix##4) \
+    IMOCK_TEST_METHODS_10(prefix##5) \
+    IMOCK_TEST_METHODS_10(prefix##6) \
+    IMOCK_TEST_METHODS_10(prefix##7) \
+    IMOCK_TEST_METHODS_10(prefix##8) \
+    IMOCK_TEST_METHODS_10(prefix##9)
+#define IMOCK_TEST_METHODS_1000(prefix) \
+    IMOCK_TEST_METHODS_100(prefix##0) \
+    IMOCK_TEST_METHODS_100(prefix##1) \
+    IMOCK_TEST_METHODS_100(prefix##2) \
+    IMOCK_TEST_METHODS_100(prefix##3) \
+    IMOCK_TEST_METHODS_100(prefix##4) \
+    IMOCK_TEST_METHODS_100(prefix##5) \
+    IMOCK_TEST_METHODS_100(prefix##6) \
+    IMOCK_TEST_METHODS_100(prefix##7) \
+    IMOCK_TEST_METHODS_100(prefix##8) \
+    IMOCK_TEST_METHODS_100(prefix##9)
+
+/// An interface with more methods than VirtualTableOffsetReference.
+class IMoreMethodsThanReference {
+    public:
+        IMOCK_TEST_METHODS_1000(method0)
+        IMOCK_TEST_METHODS_1000(method1)
+        IMOCK_TEST_METHODS_1000(method2)
+        IMOCK_TEST_METHODS_1000(method3)
+        IMOCK_TEST_METHODS_1000(method4)
+};
+
+#undef IMOCK_TEST_METHODS_10
+#undef IMOCK_TEST_METHODS_100
+#undef IMOCK_TEST_METHODS_1000
+
+TEST_CASE("can mock an interface with more than 4096 methods",
+    "[virtual_table]") {
+    // Only mock the interface when offsets are read from method pointers,
+    // since VirtualTableOffsetReference only has 4096 methods.
+    if(!IMock::Internal::VirtualTableOffsetContext::readsMethodPointers) {
+        return;
+    }
+
+    // Create a Mock of IMoreMethodsThanReference and mock methods on both
+    // sides of the limit with different values.
+    IMock::Mock<IMoreMethodsThanReference> mock;
+    when(mock, method0000)
+        .with()
+        .returns(1);
+    when(mock, method4095)
+        .with()
+        .returns(2);
+    when(mock, method4096)
+        .with()
+        .returns(3);
+    when(mock, method4999)
+        .with()
+        .returns(4);
+
+    // Verify every call reaches the mock case of its own method.
+    REQUIRE(mock.get().method0000() == 1);
+    REQUIRE(mock.get().method4095() == 2);
+    REQUIRE(mock.get().method4096() == 3);
+    REQUIRE(mock.get().method4999() == 4);
+
+    // Verify the other methods are not mocked.
+    REQUIRE_THROWS_AS(
+        mock.get().method4998(),
+        IMock::Exception::UnknownCallException);
+}
+
+TEST_CASE("mock cases are matched in the order of precedence", "[precedence]") {
+    // Create a Mock of ICalculator.
+    IMock::Mock<ICalculator> mock;
+
+    // Mock add with arguments.
+    IMock::CallCount callCountFirst = when(mock, add)
+        .with(1, 1)
+        .returns(2);
+
+    SECTION("a more recent mock case with the same arguments has precedence") {
+        // Mock add with the same arguments again.
+        IMock::CallCount callCountSecond = when(mock, add)
+            .with(1, 1)
+            .returns(3);
+
+        // Call add with the mocked values.
+        int result = mock.get().add(1, 1);
+
+        // Verify the most recent mock case handled the call.
+        REQUIRE(result == 3);
+        REQUIRE_NOTHROW(callCountFirst.verifyNeverCalled());
+        REQUIRE_NOTHROW(callCountSecond.verifyCalledOnce());
+    }
+
+    SECTION("a more recent fake has precedence") {
+        // Mock add with a fake.
+        IMock::CallCount callCountFake = when(mock, add)
+            .fake([](int a, int b) {
+                return a * b;
+            });
+
+        // Call add with the mocked values.
+        int result = mock.get().add(1, 1);
+
+        // Verify the fake handled the call.
+        REQUIRE(result == 1);
+        REQUIRE_NOTHROW(callCountFirst.verifyNeverCalled());
+        REQUIRE_NOTHROW(callCountFake.verifyCalledOnce());
+    }
+
+    SECTION("an older fake only handles calls not matching newer mock cases") {
+        // Mock add with a fake.
+        IMock::CallCount callCountFake = when(mock, add)
+            .fake([](int a, int b) {
+                return a * b;
+            });
+
+        // Mock add with arguments after the fake.
+        IMock::CallCount callCountSecond = when(mock, add)
+            .with(2, 3)
+            .returns(5);
+
+        // Verify the newer mock case handles calls with its arguments.
+        REQUIRE(mock.get().add(2, 3) == 5);
+
+        // Verify the fake handles calls with other arguments, including the
+        // arguments of the older mock case.
+        REQUIRE(mock.get().add(1, 1) == 1);
+        REQUIRE(mock.get().add(3, 3) == 9);
+
+        // Verify the call counts.
+        REQUIRE_NOTHROW(callCountFirst.verifyNeverCalled());
+        REQUIRE_NOTHROW(callCountFake.verifyCallCount(2));
+        REQUIRE_NOTHROW(callCountSecond.verifyCalledOnce());
+    }
+
+    SECTION("a fake added after mock cases with matchers has precedence") {
+        // Mock add with a fake, a matcher and then another fake.
+        IMock::CallCount callCountFake = when(mock, add)
+            .fake([](int a, int b) {
+                return a * b;
+            });
+        IMock::CallCount callCountMatcher = when(mock, add)
+            .with(IMock::any<int>(), 2)
+            .returns(4);
+
+        // Verify the matcher handles calls before the newer fake is added.
+        REQUIRE(mock.get().add(3, 2) == 4);
+        REQUIRE(mock.get().add(3, 3) == 9);
+
+        // Add the newer fake.
+        IMock::CallCount callCountNewerFake = when(mock, add)
+            .fake([](int a, int b) {
+                return a - b;
+            });
+
+        // Verify the newer fake handles every call.
+        REQUIRE(mock.get().add(3, 2) == 1);
+        REQUIRE(mock.get().add(1, 1) == 0);
+
+        // Verify the call counts.
+        REQUIRE_NOTHROW(callCountFake.verifyCalledOnce());
+        REQUIRE_NOTHROW(callCountMatcher.verifyCalledOnce());
+        REQUIRE_NOTHROW(callCountNewerFake.verifyCallCount(2));
+    }
+}
+
+TEST_CASE("can mock a method a large number of times", "[many_cases]") {
+    // Declare the number of mock cases, which is large enough to require
+    // several segments of storage.
+    const int mockCaseCount = 1000;
+
+    // Create values to use as arguments and return values. The values must be
+    // kept alive since IConstantReferenceCalculator uses references, which
+    // also means the mock cases are not indexed.
+    std::vector<int> values(mockCaseCount);
+    for(int i = 0; i < mockCaseCount; i++) {
+        values[i] = i;
+    }
+
+    // Create a Mock of IConstantReferenceCalculator.
+    IMock::Mock<IConstantReferenceCalculator> mock;
+
+    // Mock add for every value and store the call counts.
+    std::vector<IMock::CallCount> callCounts;
+    for(int i = 0; i < mockCaseCount; i++) {
+        callCounts.push_back(when(mock, add)
+            .with(values[i], values[i])
+            .returns(values[i]));
+    }
+
+    // Call add once for every value and verify the results.
+    for(int i = 0; i < mockCaseCount; i++) {
+        REQUIRE(mock.get().add(i, i) == i);
+    }
+
+    // Verify every mock case has been called once.
+    for(int i = 0; i < mockCaseCount; i++) {
+        REQUIRE_NOTHROW(callCounts[i].verifyCalledOnce());
+    }
+}
+
+TEST_CASE("a CallCount can be used after its Mock has been destroyed",
+    "[call_count]") {
+    // Declare a CallCount to assign within a scope.
+    std::unique_ptr<IMock::CallCount> callCount;
+
+    {
+        // Create a Mock of ICalculator.
+        IMock::Mock<ICalculator> mock;
+
+        // Mock add.
+        callCount = IMock::Internal::makeUnique<IMock::CallCount>(
+            when(mock, add)
+                .with(1, 1)
+                .returns(2));
+
+        // Call add with the mocked values.
+        mock.get().add(1, 1);
+    }
+
+    // Verify the call count after the Mock has been destroyed.
+    REQUIRE_NOTHROW(callCount->verifyCalledOnce());
+}
+
+/// An interface with methods with and without return values.
+class ICounter {
+    public:
+        virtual int add(int, int) = 0;
+        virtual int subtract(int, int) = 0;
+        virtual void reset(int) = 0;
+};
+
+TEST_CASE("mocked calls do not allocate memory", "[allocation]") {
+    // Create a Mock of ICounter.
+    IMock::Mock<ICounter> mock;
+
+    // Mock the methods using returns and fake with and without arguments.
+    when(mock, add)
+        .with(1, 1)
+        .returns(2);
+    when(mock, add)
+        .with(2, 2)
+        .fake([](int a, int b) {
+            return a + b;
+        });
+    when(mock, subtract)
+        .fake([](int a, int b) {
+            return a - b;
+        });
+    when(mock, reset)
+        .with(0)
+        .returns();
+
+    // Get the number of allocations before the calls.
+    std::size_t allocationCountBefore = allocationCount;
+
+    // Call every mocked method.
+    int result = mock.get().add(1, 1)
+        + mock.get().add(2, 2)
+        + mock.get().subtract(5, 1);
+    mock.get().reset(0);
+
+    // Get the number of allocations after the calls.
+    std::size_t allocationCountAfter = allocationCount;
+
+    // Verify the calls returned the correct values.
+    REQUIRE(result == 10);
+
+    // Verify no memory was allocated during the calls.
+    REQUIRE(allocationCountAfter == allocationCountBefore);
+}
+
+TEST_CASE("can call and mock methods from several threads at once",
+    "[concurrency]") {
+    // The number of threads calling the mocked methods.
+    const int callerCount = 4;
+
+    // The number of calls every calling thread makes to each method.
+    const int callCount = 20000;
+
+    // The number of mock cases added while the calls are being made.
+    const int addedMockCaseCount = 2000;
+
+    // Create a Mock of ICalculator that can be used by several threads.
+    IMock::Mock<ICalculator> mock(IMock::Concurrency::Concurrent);
+
+    // Mock add with specific arguments and multiply with a fake before the
+    // threads start.
+    IMock::CallCount addCallCount = when(mock, add)
+        .with(0, 0)
+        .returns(0);
+    IMock::CallCount multiplyCallCount = when(mock, multiply)
+        .fake([](int a, int b) {
+            return a * b;
+        });
+
+    // Keep track of whether any thread got an unexpected result.
+    std::atomic<bool> failed(false);
+
+    // Keep track of the number of calls that matched a mock case added while
+    // the calls were being made.
+    std::atomic<int> addedMockCaseCallCount(0);
+
+    // Start the threads calling the mocked methods.
+    std::vector<std::thread> callers;
+    for(int caller = 0; caller < callerCount; caller++) {
+        callers.emplace_back([&, caller]() {
+            for(int call = 0; call < callCount; call++) {
+                // Call the methods mocked before the threads started.
+                if(mock.get().add(0, 0) != 0
+                    || mock.get().multiply(caller, call) != caller * call) {
+                    failed = true;
+                }
+
+                // Call add with arguments that may or may not have been
+                // mocked yet.
+                int value = call % addedMockCaseCount + 1;
+                try {
+                    if(mock.get().add(value, -value) != value) {
+                        failed = true;
+                    }
+                    addedMockCaseCallCount++;
+                }
+                catch(const IMock::Exception::UnmockedCallException&) {
+                }
+            }
+        });
+    }
+
+    // Add mock cases to add while the threads are calling it.
+    std::vector<IMock::CallCount> addedCallCounts;
+    for(int value = 1; value <= addedMockCaseCount; value++) {
+        addedCallCounts.push_back(when(mock, add)
+            .with(value, -value)
+            .returns(value));
+    }
+
+    // Wait for the threads to finish.
+    for(std::thread& caller : callers) {
+        caller.join();
+    }
+
+    // Verify every call got the expected result.
+    REQUIRE(!failed);
+
+    // Verify the calls were counted exactly.
+    REQUIRE(addCallCount.getCallCount() == callerCount * callCount);
+    REQUIRE(multiplyCallCount.getCallCount() == callerCount * callCount);
+
+    // Verify every call to an added mock case was counted exactly.
+    int addedCallCountSum = 0;
+    for(IMock::CallCount& addedCallCount : addedCallCounts) {
+        addedCallCountSum += addedCallCount.getCallCount();
+    }
+    REQUIRE(addedCallCountSum == addedMockCaseCallCount);
+
+    // Verify every added mock case can be called afterwards.
+    for(int value = 1; value <= addedMockCaseCount; value++) {
+        REQUIRE(mock.get().add(value, -value) == value);
+    }
+}
+
+/// An interface with a reference argument without a copy constructor.
+class INoCopyReference {
+    public:
+        virtual void setInt(NoCopy&) = 0;
+};
+
+TEST_CASE("concurrent mocks only mock new methods before calls can be made",
+    "[concurrency]") {
+    // Create a Mock of ICalculator that can be used by several threads and
+    // mock add.
+    IMock::Mock<ICalculator> mock(IMock::Concurrency::Concurrent);
+    when(mock, add)
+        .with(1, 1)
+        .returns(2);
+
+    // Get the instance of the interface, after which calls may be made.
+    ICalculator& calculator = mock.get();
+
+    // Verify a method without mock cases can't be mocked.
+    auto mockWithArguments = when(mock, subtract).with(1, 1);
+    REQUIRE_THROWS_AS(
+        mockWithArguments.returns(0),
+        IMock::Exception::MethodMockedAfterCallsException);
+
+    // Verify more mock cases can be added to a mocked method.
+    when(mock, add)
+        .with(2, 2)
+        .returns(4);
+    REQUIRE(calculator.add(2, 2) == 4);
+
+    // Verify the method can be mocked once the mock has been reset.
+    mock.reset();
+    when(mock, subtract)
+        .with(1, 1)
+        .returns(0);
+    REQUIRE(mock.get().subtract(1, 1) == 0);
+}
+
+TEST_CASE("concurrent call counts only allocate memory when contended",
+    "[concurrency]") {
+    // Create a Mock of ICalculator that can be used by several threads.
+    IMock::Mock<ICalculator> mock(IMock::Concurrency::Concurrent);
+
+    // Get the number of allocations before the mock cases are added.
+    std::size_t allocationCountBefore = allocationCount;
+
+    // Add a large number of mock cases and call each of them once.
+    for(int value = 0; value < 1000; value++) {
+        when(mock, add)
+            .with(value, value)
+            .returns(value);
+        mock.get().add(value, value);
+    }
+
+    // Verify the call counts did not allocate memory one by one.
+    REQUIRE(allocationCount - allocationCountBefore < 100);
+}
+
+/// An interface taking a C string.
+class IText {
+    public:
+        virtual int length(const char*) = 0;
+};
+
+TEST_CASE("unmocked calls create their exception messages when needed",
+    "[unmocked_call]") {
+    SECTION("with reference arguments that change after the call") {
+        // Create a Mock of IReferenceCalculator and mock add.
+        IMock::Mock<IReferenceCalculator> mock;
+        int one = 1;
+        int result = 2;
+        when(mock, add)
+            .with(one, one)
+            .returns(result);
+
+        // Make an unmocked call and catch the exception.
+        int a = 2;
+        int b = 3;
+        IMock::Exception::UnmockedCallException exception("");
+        try {
+            mock.get().add(a, b);
+        }
+        catch(const IMock::Exception::UnmockedCallException& thrown) {
+            exception = thrown;
+        }
+
+        // Change the arguments before the message is created.
+        a = 5;
+        b = 6;
+
+        // Verify the message contains the arguments of the call.
+        REQUIRE(std::string(exception.what()) == "The call mock.get().add(2, "
+            "3) does not match any mocked case.");
+
+        // Verify a copy has the same message.
+        IMock::Exception::UnmockedCallException copy = exception;
+        REQUIRE(std::string(copy.what()) == exception.what());
+    }
+
+    SECTION("with reference arguments that can't be copied") {
+        // Create a Mock of INoCopyReference and mock setInt.
+        IMock::Mock<INoCopyReference> mock;
+        NoCopy one(1);
+        when(mock, setInt)
+            .with(one)
+            .returns();
+
+        // Make an unmocked call and verify the message.
+        NoCopy two(2);
+        REQUIRE_THROWS_MATCHES(
+            mock.get().setInt(two),
+            IMock::Exception::UnmockedCallException,
+            Catch::Message("The call mock.get().setInt(?) does not match any "
+                "mocked case."));
+    }
+
+    SECTION("with a C string that is freed after the call") {
+        // Create a Mock of IText and mock length for a null pointer.
+        IMock::Mock<IText> mock;
+        when(mock, length)
+            .with(nullptr)
+            .returns(0);
+
+        // Make an unmocked call with a string on the heap and catch the
+        // exception.
+        char* text = new char[5];
+        std::strcpy(text, "text");
+        IMock::Exception::UnmockedCallException exception("");
+        try {
+            mock.get().length(text);
+        }
+        catch(const IMock::Exception::UnmockedCallException& thrown) {
+            exception = thrown;
+        }
+
+        // Overwrite and free the string before the message is created.
+        std::strcpy(text, "free");
+        delete[] text;
+
+        // Verify the message contains the string the call was made with.
+        REQUIRE(std::string(exception.what()) == "The call "
+            "mock.get().length(text) does not match any mocked case.");
+    }
+}
+
+TEST_CASE("can verify mock cases are called in order", "[sequence]") {
+    // Create two mocks.
+    IMock::Mock<ICalculator> calculatorMock;
+    IMock::Mock<INoReturnValue> noReturnValueMock;
+
+    // Add mock cases to both mocks.
+    IMock::CallCount first = when(calculatorMock, add)
+        .with(1, 1)
+        .returns(2);
+    IMock::CallCount second = when(noReturnValueMock, setInt)
+        .with(2)
+        .returns();
+    IMock::CallCount third = when(calculatorMock, add)
+        .with(3, 3)
+        .returns(6);
+
+    // Create an InSequence with the mock cases.
+    IMock::InSequence sequence;
+    sequence
+        .add(first)
+        .add(second)
+        .add(third);
+
+    SECTION("calls in order") {
+        // Call the steps in order, calling the second step twice.
+        calculatorMock.get().add(1, 1);
+        noReturnValueMock.get().setInt(2);
+        noReturnValueMock.get().setInt(2);
+        calculatorMock.get().add(3, 3);
+
+        // Verify the sequence is complete and the calls were counted.
+        REQUIRE_NOTHROW(sequence.verify());
+        REQUIRE_NOTHROW(second.verifyCallCount(2));
+    }
+
+    SECTION("call a step before the first step") {
+        // Verify the call throws a WrongCallOrderException immediately.
+        REQUIRE_THROWS_MATCHES(
+            noReturnValueMock.get().setInt(2),
+            IMock::Exception::WrongCallOrderException,
+            Catch::Message("Step 2 of a sequence was called before step 1."));
+
+        // Verify the call was not counted.
+        REQUIRE_NOTHROW(second.verifyNeverCalled());
+    }
+
+    SECTION("skip a step") {
+        // Call the first step and then the third step.
+        calculatorMock.get().add(1, 1);
+        REQUIRE_THROWS_MATCHES(
+            calculatorMock.get().add(3, 3),
+            IMock::Exception::WrongCallOrderException,
+            Catch::Message("Step 3 of a sequence was called after step 1."));
+    }
+
+    SECTION("call a previous step again") {
+        // Call the first two steps and then the first step again.
+        calculatorMock.get().add(1, 1);
+        noReturnValueMock.get().setInt(2);
+        REQUIRE_THROWS_MATCHES(
+            calculatorMock.get().add(1, 1),
+            IMock::Exception::WrongCallOrderException,
+            Catch::Message("Step 1 of a sequence was called after step 2."));
+    }
+
+    SECTION("verify an incomplete sequence") {
+        // Call the first step only.
+        calculatorMock.get().add(1, 1);
+
+        // Verify the sequence is reported as incomplete.
+        REQUIRE_THROWS_MATCHES(
+            sequence.verify(),
+            IMock::Exception::IncompleteSequenceException,
+            Catch::Message("Expected all 3 steps of the sequence to be called "
+                "but only 1 of them was called."));
+    }
+
+    SECTION("verify a sequence missing its last step") {
+        // Call the first two steps only.
+        calculatorMock.get().add(1, 1);
+        noReturnValueMock.get().setInt(2);
+
+        // Verify the sequence is reported as incomplete.
+        REQUIRE_THROWS_MATCHES(
+            sequence.verify(),
+            IMock::Exception::IncompleteSequenceException,
+            Catch::Message("Expected all 3 steps of the sequence to be called "
+                "but only 2 of them were called."));
+    }
+
+    SECTION("add a mock case twice") {
+        // Verify a mock case can't be added again.
+        IMock::InSequence otherSequence;
+        REQUIRE_THROWS_AS(
+            otherSequence.add(first),
+            IMock::Exception::MockCaseInSequenceTwiceException);
+    }
+}
+
+TEST_CASE("can match arguments with matchers", "[matchers]") {
+    // Create a mock.
+    IMock::Mock<ICalculator> mock;
+
+    SECTION("match any value") {
+        // Add a mock case matching any first argument.
+        IMock::CallCount callCount = when(mock, add)
+            .with(IMock::any<int>(), 2)
+            .returns(3);
+
+        // Verify any first argument matches but the second must be equal.
+        REQUIRE(mock.get().add(1, 2) == 3);
+        REQUIRE(mock.get().add(-100, 2) == 3);
+        REQUIRE_THROWS_AS(
+            mock.get().add(1, 3),
+            IMock::Exception::UnmockedCallException);
+        REQUIRE_NOTHROW(callCount.verifyCallCount(2));
+    }
+
+    SECTION("match with comparisons") {
+        // Add mock cases with every comparison.
+        when(mock, add)
+            .with(IMock::lessThan(0), IMock::equalTo(0))
+            .returns(1);
+        when(mock, add)
+            .with(IMock::lessThanOrEqualTo(0), IMock::notEqualTo(0))
+            .returns(2);
+        when(mock, add)
+            .with(IMock::greaterThan(0), IMock::any<int>())
+            .returns(3);
+        when(mock, add)
+            .with(IMock::greaterThanOrEqualTo(10), IMock::any<int>())
+            .returns(4);
+
+        // Verify the comparisons.
+        REQUIRE(mock.get().add(-1, 0) == 1);
+        REQUIRE(mock.get().add(0, 1) == 2);
+        REQUIRE(mock.get().add(-1, 1) == 2);
+        REQUIRE(mock.get().add(1, 0) == 3);
+        REQUIRE(mock.get().add(10, 0) == 4);
+        REQUIRE_THROWS_AS(
+            mock.get().add(0, 0),
+            IMock::Exception::UnmockedCallException);
+    }
+
+    SECTION("match with a predicate") {
+        // Add a mock case matching even numbers.
+        when(mock, add)
+            .with(
+                IMock::matching<int>([](int value) {
+                    return value % 2 == 0;
+                }),
+                IMock::any<int>())
+            .returns(1);
+
+        // Verify only even numbers match.
+        REQUIRE(mock.get().add(2, 1) == 1);
+        REQUIRE_THROWS_AS(
+            mock.get().add(3, 1),
+            IMock::Exception::UnmockedCallException);
+    }
+
+    SECTION("match reference arguments") {
+        // Create a mock with reference arguments.
+        IMock::Mock<IConstantReferenceCalculator> referenceMock;
+        int result = 5;
+        when(referenceMock, add)
+            .with(IMock::any<int>(), IMock::lessThan(5))
+            .returns(result);
+
+        // Verify calls are matched.
+        REQUIRE(referenceMock.get().add(1, 4) == 5);
+        REQUIRE_THROWS_AS(
+            referenceMock.get().add(1, 5),
+            IMock::Exception::UnmockedCallException);
+    }
+
+    SECTION("match arguments without copy constructors") {
+        // Create a mock with arguments without copy constructors.
+        IMock::Mock<INoCopy> noCopyMock;
+        IMock::CallCount callCount = when(noCopyMock, setInt)
+            .with(IMock::matching<NoCopy>([](const NoCopy& value) {
+                return value.getValue() > 1;
+            }))
+            .returns();
+        when(noCopyMock, id)
+            .with(IMock::equalTo(NoCopy(1)))
+            .fake([](NoCopy value) {
+                return value;
+            });
+
+        // Verify calls are matched.
+        noCopyMock.get().setInt(NoCopy(2));
+        REQUIRE(noCopyMock.get().id(NoCopy(1)).getValue() == 1);
+        REQUIRE_NOTHROW(callCount.verifyCalledOnce());
+    }
+
+    SECTION("exact mock cases and mock cases with matchers have precedence "
+        "in the order they were added") {
+        // Add exact mock cases around a mock case with matchers.
+        when(mock, add)
+            .with(1, 1)
+            .returns(1);
+        when(mock, add)
+            .with(IMock::any<int>(), IMock::any<int>())
+            .returns(2);
+        when(mock, add)
+            .with(2, 2)
+            .returns(3);
+
+        // Verify the most recently added matching mock case is used.
+        REQUIRE(mock.get().add(1, 1) == 2);
+        REQUIRE(mock.get().add(2, 2) == 3);
+        REQUIRE(mock.get().add(3, 3) == 2);
+    }
+
+    SECTION("a few mock cases with matchers next to many exact mock cases") {
+        // Add a mock case with matchers and many exact mock cases after it.
+        when(mock, add)
+            .with(IMock::any<int>(), IMock::lessThan(0))
+            .returns(-1);
+        const int caseCount = 1000;
+        for(int index = 0; index < caseCount; index++) {
+            when(mock, add)
+                .with(index, index)
+                .returns(index * 2);
+        }
+
+        // Verify both kinds of mock cases are found.
+        for(int index = 0; index < caseCount; index++) {
+            REQUIRE(mock.get().add(index, index) == index * 2);
+        }
+        REQUIRE(mock.get().add(5, -5) == -1);
+    }
+}
+
+/// Counts how many times instances are copied and moved.
+class CopyCounter {
+    public:
+        /// The number of copies made.
+        static int copyCount;
+
+        /// The number of moves made.
+        static int moveCount;
+
+        CopyCounter() {
+        }
+
+        CopyCounter(const CopyCounter&) {
+            copyCount++;
+        }
+
+        CopyCounter(CopyCounter&&) {
+            moveCount++;
+        }
+
+        bool operator == (const CopyCounter&) const {
+            return true;
+        }
+};
+
+int CopyCounter::copyCount = 0;
+int CopyCounter::moveCount = 0;
+
+class IForwarding {
+    public:
+        virtual int take(CopyCounter) = 0;
+        virtual int takeVector(std::vector<int>) = 0;
+};
+
+TEST_CASE("calls do not copy or move arguments needlessly", "[forwarding]") {
+    // Create a mock.
+    IMock::Mock<IForwarding> mock;
+
+    SECTION("match an exact mock case") {
+        // Add a mock case requiring an argument.
+        when(mock, take)
+            .with(CopyCounter())
+            .returns(1);
+
+        // Call the mock with an argument created in place.
+        CopyCounter::copyCount = 0;
+        CopyCounter::moveCount = 0;
+        REQUIRE(mock.get().take(CopyCounter()) == 1);
+
+        // Verify the argument was neither copied nor moved.
+        REQUIRE(CopyCounter::copyCount == 0);
+        REQUIRE(CopyCounter::moveCount == 0);
+    }
+
+    SECTION("match a mock case with a matcher") {
+        // Add a mock case with a matcher.
+        when(mock, take)
+            .with(IMock::any<CopyCounter>())
+            .returns(1);
+
+        // Call the mock with an argument created in place.
+        CopyCounter::copyCount = 0;
+        CopyCounter::moveCount = 0;
+        REQUIRE(mock.get().take(CopyCounter()) == 1);
+
+        // Verify the argument was neither copied nor moved.
+        REQUIRE(CopyCounter::copyCount == 0);
+        REQUIRE(CopyCounter::moveCount == 0);
+    }
+
+    SECTION("call a fake") {
+        // Add a fake taking the argument by reference.
+        when(mock, take).fake([](const CopyCounter&) {
+            return 1;
+        });
+
+        // Call the mock with an argument created in place.
+        CopyCounter::copyCount = 0;
+        CopyCounter::moveCount = 0;
+        REQUIRE(mock.get().take(CopyCounter()) == 1);
+
+        // Verify the argument was only moved into the std::function.
+        REQUIRE(CopyCounter::copyCount == 0);
+        REQUIRE(CopyCounter::moveCount <= 1);
+    }
+
+    SECTION("hand a container to a fake") {
+        // Add a fake keeping the vector it is given.
+        std::vector<int> kept;
+        when(mock, takeVector).fake([&](std::vector<int> vector) {
+            kept = std::move(vector);
+            return 1;
+        });
+
+        // Call the mock with a moved vector.
+        std::vector<int> vector(1000, 1);
+        const int* data = vector.data();
+        REQUIRE(mock.get().takeVector(std::move(vector)) == 1);
+
+        // Verify the fake received the same buffer.
+        REQUIRE(kept.data() == data);
+    }
+}
+
+/// An interface returning a container of values without copy constructors.
+class IMoveOnlyContainer {
+    public:
+        virtual std::vector<std::unique_ptr<int>> getPointers() = 0;
+};
+
+TEST_CASE("can return a sequence of values", "[return_sequences]") {
+    SECTION("return values in order and then the last value") {
+        // Add a mock case returning three values.
+        IMock::Mock<ICalculator> mock;
+        IMock::CallCount callCount = when(mock, add)
+            .with(1, 1)
+            .returns(1, 2, 3);
+
+        // Verify the values are returned in order and that the last value is
+        // repeated.
+        REQUIRE(mock.get().add(1, 1) == 1);
+        REQUIRE(mock.get().add(1, 1) == 2);
+        REQUIRE(mock.get().add(1, 1) == 3);
+        REQUIRE(mock.get().add(1, 1) == 3);
+        REQUIRE(mock.get().add(1, 1) == 3);
+        REQUIRE_NOTHROW(callCount.verifyCallCount(5));
+    }
+
+    SECTION("return values with a matcher") {
+        // Add a mock case with a matcher returning two values.
+        IMock::Mock<ICalculator> mock;
+        when(mock, add)
+            .with(IMock::any<int>(), IMock::any<int>())
+            .returns(4, 5);
+
+        // Verify the values are shared by every matching call.
+        REQUIRE(mock.get().add(1, 2) == 4);
+        REQUIRE(mock.get().add(3, 4) == 5);
+        REQUIRE(mock.get().add(5, 6) == 5);
+    }
+
+    SECTION("return references") {
+        // Add a mock case returning two references.
+        IMock::Mock<IConstantReferenceCalculator> mock;
+        int one = 1;
+        int first = 10;
+        int second = 20;
+        when(mock, add)
+            .with(one, one)
+            .returns(first, second);
+
+        // Verify the references are returned.
+        REQUIRE(&mock.get().add(1, 1) == &first);
+        REQUIRE(&mock.get().add(1, 1) == &second);
+        REQUIRE(&mock.get().add(1, 1) == &second);
+    }
+
+    SECTION("return values without copy constructors once each") {
+        // Add a mock case returning two values without copy constructors.
+        IMock::Mock<INoCopy> mock;
+        when(mock, getInt)
+            .with()
+            .returns(NoCopy(1), NoCopy(2));
+
+        // Verify every value is returned once.
+        REQUIRE(mock.get().getInt().getValue() == 1);
+        REQUIRE(mock.get().getInt().getValue() == 2);
+        REQUIRE_THROWS_MATCHES(
+            mock.get().getInt(),
+            IMock::Exception::ReturnValuesExhaustedException,
+            Catch::Message("Every return value of a mock case has already "
+                "been returned. Values without copy constructors and values "
+                "passed to returnsOnce are only returned once."));
+    }
+
+    SECTION("return containers of values without copy constructors once "
+        "each") {
+        // Add a mock case returning two vectors of unique pointers, which
+        // claim to be copyable although their values can't be copied.
+        IMock::Mock<IMoveOnlyContainer> mock;
+        std::vector<std::unique_ptr<int>> first;
+        first.emplace_back(new int(1));
+        std::vector<std::unique_ptr<int>> second;
+        second.emplace_back(new int(2));
+        when(mock, getPointers)
+            .with()
+            .returnsOnce(std::move(first), std::move(second));
+
+        // Verify every vector is returned once.
+        REQUIRE(*mock.get().getPointers().at(0) == 1);
+        REQUIRE(*mock.get().getPointers().at(0) == 2);
+        REQUIRE_THROWS_AS(
+            mock.get().getPointers(),
+            IMock::Exception::ReturnValuesExhaustedException);
+    }
+
+    SECTION("return copyable values once each") {
+        // Add a mock case returning two values once each.
+        IMock::Mock<ICalculator> mock;
+        IMock::CallCount callCount = when(mock, add)
+            .with(1, 1)
+            .returnsOnce(1, 2);
+
+        // Verify the last value is not repeated.
+        REQUIRE(mock.get().add(1, 1) == 1);
+        REQUIRE(mock.get().add(1, 1) == 2);
+        REQUIRE_THROWS_AS(
+            mock.get().add(1, 1),
+            IMock::Exception::ReturnValuesExhaustedException);
+        REQUIRE_NOTHROW(callCount.verifyCallCount(3));
+    }
+}
+
+TEST_CASE("repeated calls use the last matching mock case correctly",
+    "[last_hit]") {
+    SECTION("repeat calls to an old mock case that can't be indexed") {
+        // Add many mock cases for arguments that can't be indexed.
+        IMock::Mock<INoCopy> mock;
+        std::vector<IMock::CallCount> callCounts;
+        for(int value = 0; value < 100; value++) {
+            callCounts.push_back(when(mock, setInt)
+                .with(NoCopy(value))
+                .returns());
+        }
+
+        // Repeat calls to the oldest mock case and then another one.
+        mock.get().setInt(NoCopy(0));
+        mock.get().setInt(NoCopy(0));
+        mock.get().setInt(NoCopy(50));
+        mock.get().setInt(NoCopy(0));
+
+        // Verify the calls were handled by the right mock cases.
+        REQUIRE_NOTHROW(callCounts[0].verifyCallCount(3));
+        REQUIRE_NOTHROW(callCounts[50].verifyCalledOnce());
+
+        // Add a newer mock case with the same arguments.
+        IMock::CallCount newerCallCount = when(mock, setInt)
+            .with(NoCopy(0))
+            .returns();
+
+        // Verify the newer mock case takes precedence.
+        mock.get().setInt(NoCopy(0));
+        REQUIRE_NOTHROW(callCounts[0].verifyCallCount(3));
+        REQUIRE_NOTHROW(newerCallCount.verifyCalledOnce());
+    }
+
+    SECTION("a newer mock case with a matcher takes precedence") {
+        // Add an exact mock case and call it twice.
+        IMock::Mock<ICalculator> mock;
+        when(mock, add)
+            .with(1, 1)
+            .returns(2);
+        REQUIRE(mock.get().add(1, 1) == 2);
+        REQUIRE(mock.get().add(1, 1) == 2);
+
+        // Add a newer mock case with a matcher and verify it is used.
+        when(mock, add)
+            .with(IMock::any<int>(), 1)
+            .returns(3);
+        REQUIRE(mock.get().add(1, 1) == 3);
+        REQUIRE(mock.get().add(1, 1) == 3);
+    }
+
+    SECTION("an older mock case with a matcher does not hide newer ones") {
+        // Add a mock case with a matcher and a newer exact mock case.
+        IMock::Mock<ICalculator> mock;
+        when(mock, add)
+            .with(IMock::any<int>(), IMock::any<int>())
+            .returns(1);
+        when(mock, add)
+            .with(2, 2)
+            .returns(2);
+
+        // Verify calls alternate between them correctly.
+        REQUIRE(mock.get().add(1, 1) == 1);
+        REQUIRE(mock.get().add(2, 2) == 2);
+        REQUIRE(mock.get().add(1, 1) == 1);
+        REQUIRE(mock.get().add(2, 2) == 2);
+    }
+
+    SECTION("a newer mock case with a stateful matcher takes precedence") {
+        // Add an exact mock case, a newer mock case with a matcher whose
+        // result can change and an even newer exact mock case.
+        IMock::Mock<ICalculator> mock;
+        bool enabled = false;
+        when(mock, add)
+            .with(1, 1)
+            .returns(10);
+        when(mock, add)
+            .with(
+                IMock::matching<int>([&](const int&) {
+                    return enabled;
+                }),
+                IMock::any<int>())
+            .returns(20);
+        when(mock, add)
+            .with(2, 2)
+            .returns(30);
+
+        // Call the oldest mock case.
+        REQUIRE(mock.get().add(1, 1) == 10);
+
+        // Let the matcher match and verify it takes precedence.
+        enabled = true;
+        REQUIRE(mock.get().add(1, 1) == 20);
+    }
+
+    SECTION("referenced arguments may change between calls") {
+        // Add two mock cases with referenced arguments.
+        IMock::Mock<IConstantReferenceCalculator> mock;
+        int older = 1;
+        int newer = 2;
+        int olderResult = 10;
+        int newerResult = 20;
+        when(mock, add)
+            .with(older, older)
+            .returns(olderResult);
+        when(mock, add)
+            .with(newer, newer)
+            .returns(newerResult);
+
+        // Call the older mock case.
+        REQUIRE(mock.get().add(1, 1) == 10);
+
+        // Change the arguments of the newer mock case and verify it takes
+        // precedence.
+        newer = 1;
+        REQUIRE(mock.get().add(1, 1) == 20);
+    }
+}
+
+/// A function used as a fake.
+///
+/// @param a The first term.
+/// @param b The second term.
+/// @return The difference.
+int subtractFunction(int a, int b) {
+    return a - b;
+}
+
+TEST_CASE("fakes can be any callable", "[fakes]") {
+    // Create a mock.
+    IMock::Mock<ICalculator> mock;
+
+    SECTION("a mutable lambda") {
+        // Add a fake counting its calls.
+        int calls = 0;
+        when(mock, add).fake([calls](int, int) mutable {
+            return ++calls;
+        });
+
+        // Verify the state of the fake is kept between calls.
+        REQUIRE(mock.get().add(1, 1) == 1);
+        REQUIRE(mock.get().add(1, 1) == 2);
+    }
+
+    SECTION("a lambda capturing a value without a copy constructor") {
+        // Create a value without a copy constructor and a fake owning it.
+        std::unique_ptr<int> value(new int(5));
+        struct Fake {
+            std::unique_ptr<int> value;
+
+            int operator () (int a, int b) const {
+                return *value + a + b;
+            }
+        };
+        Fake fake;
+        fake.value = std::move(value);
+        when(mock, add)
+            .with(1, 1)
+            .fake(std::move(fake));
+
+        // Verify the fake is called.
+        REQUIRE(mock.get().add(1, 1) == 7);
+    }
+
+    SECTION("a function") {
+        // Add a function as a fake.
+        when(mock, subtract).fake(subtractFunction);
+
+        // Verify the function is called.
+        REQUIRE(mock.get().subtract(5, 3) == 2);
+    }
+
+    SECTION("a std::function") {
+        // Add a std::function as a fake.
+        when(mock, multiply).fake(std::function<int (int, int)>(
+            [](int a, int b) {
+                return a * b;
+            }));
+
+        // Verify the std::function is called.
+        REQUIRE(mock.get().multiply(5, 3) == 15);
+    }
+
+    SECTION("a large lambda is called without allocating memory") {
+        // Add a fake capturing more than a std::function can store inline.
+        long long a = 1;
+        long long b = 2;
+        long long c = 3;
+        long long d = 4;
+        when(mock, add).fake([a, b, c, d](int x, int y) {
+            return static_cast<int>(a + b + c + d) + x + y;
+        });
+
+        // Verify the call does not allocate any memory.
+        size_t allocationCountBefore = allocationCount;
+        REQUIRE(mock.get().add(1, 1) == 12);
+        REQUIRE(allocationCount == allocationCountBefore);
+    }
+}
+
+TEST_CASE("can add mock cases from a table", "[table]") {
+    // Create a mock.
+    IMock::Mock<ICalculator> mock;
+
+    SECTION("from a list") {
+        // Add a mock case for every entry in a list.
+        IMock::CallCounts callCounts = when(mock, add).table({
+            {std::make_tuple(1, 2), 3},
+            {std::make_tuple(2, 3), 5},
+            {std::make_tuple(3, 4), 7}
+        });
+
+        // Verify the calls return the values of the entries.
+        REQUIRE(mock.get().add(2, 3) == 5);
+        REQUIRE(mock.get().add(3, 4) == 7);
+        REQUIRE(mock.get().add(2, 3) == 5);
+
+        // Verify calls with other arguments are not mocked.
+        REQUIRE_THROWS_AS(
+            mock.get().add(4, 5),
+            IMock::Exception::UnmockedCallException);
+
+        // Verify the call counts of the entries.
+        REQUIRE(callCounts.size() == 3);
+        REQUIRE_NOTHROW(callCounts[0].verifyNeverCalled());
+        REQUIRE_NOTHROW(callCounts[1].verifyCallCount(2));
+        REQUIRE_NOTHROW(callCounts[2].verifyCalledOnce());
+    }
+
+    SECTION("from a vector") {
+        // Create a large table of sums.
+        const int entryCount = 1000;
+        std::vector<std::pair<std::tuple<int, int>, int>> entries;
+        for(int i = 0; i < entryCount; i++) {
+            entries.emplace_back(std::make_tuple(i, i + 1), 2 * i + 1);
+        }
+
+        // Add a mock case for every entry.
+        IMock::CallCounts callCounts = when(mock, add).table(entries);
+
+        // Verify every entry is mocked and called once.
+        for(int i = 0; i < entryCount; i++) {
+            REQUIRE(mock.get().add(i, i + 1) == 2 * i + 1);
+        }
+        REQUIRE(callCounts.size() == entryCount);
+        for(int i = 0; i < entryCount; i++) {
+            REQUIRE_NOTHROW(callCounts[i].verifyCalledOnce());
+        }
+    }
+
+    SECTION("from a map") {
+        // Add a mock case for every entry in a map.
+        std::map<std::tuple<int, int>, int> entries;
+        entries[std::make_tuple(5, 3)] = 2;
+        entries[std::make_tuple(9, 4)] = 5;
+        when(mock, subtract).table(entries);
+
+        // Verify the calls return the values of the entries.
+        REQUIRE(mock.get().subtract(5, 3) == 2);
+        REQUIRE(mock.get().subtract(9, 4) == 5);
+    }
+
+    SECTION("later entries and mock cases take precedence") {
+        // Add a mock case with with, then a table containing the same
+        // arguments twice.
+        IMock::CallCount callCount = when(mock, add)
+            .with(1, 1)
+            .returns(10);
+        IMock::CallCounts callCounts = when(mock, add).table({
+            {std::make_tuple(1, 1), 20},
+            {std::make_tuple(1, 1), 30},
+            {std::make_tuple(2, 2), 40}
+        });
+
+        // Verify the last entry with the arguments is used.
+        REQUIRE(mock.get().add(1, 1) == 30);
+
+        // Add a newer mock case and verify it takes precedence over the
+        // table.
+        when(mock, add)
+            .with(2, 2)
+            .returns(50);
+        REQUIRE(mock.get().add(2, 2) == 50);
+
+        // Verify only the newest mock cases have been called.
+        REQUIRE_NOTHROW(callCount.verifyNeverCalled());
+        REQUIRE_NOTHROW(callCounts[0].verifyNeverCalled());
+        REQUIRE_NOTHROW(callCounts[1].verifyCalledOnce());
+        REQUIRE_NOTHROW(callCounts[2].verifyNeverCalled());
+    }
+
+    SECTION("from an empty list") {
+        // Add an empty table and verify no mock case is added, which leaves
+        // the method unmocked.
+        IMock::CallCounts callCounts = when(mock, add).table(
+            std::vector<std::pair<std::tuple<int, int>, int>>());
+        REQUIRE(callCounts.size() == 0);
+        REQUIRE_THROWS_AS(
+            mock.get().add(1, 1),
+            IMock::Exception::UnknownCallException);
+    }
+}
+
+TEST_CASE("can reset a mock and reuse mocks from a pool", "[reset]") {
+    SECTION("reset removes every mock case") {
+        // Create a mock and add mock cases of different kinds.
+        IMock::Mock<ICalculator> mock;
+        when(mock, add)
+            .with(1, 1)
+            .returns(2);
+        when(mock, subtract).fake(subtractFunction);
+        when(mock, multiply).table({
+            {std::make_tuple(2, 3), 6}
+        });
+
+        // Reset the mock.
+        mock.reset();
+
+        // Verify the methods behave as if they have never been mocked.
+        REQUIRE_THROWS_AS(
+            mock.get().add(1, 1),
+            IMock::Exception::UnknownCallException);
+        REQUIRE_THROWS_AS(
+            mock.get().subtract(5, 3),
+            IMock::Exception::UnknownCallException);
+        REQUIRE_THROWS_AS(
+            mock.get().multiply(2, 3),
+            IMock::Exception::UnknownCallException);
+
+        // Add new mock cases, including one with the same arguments as
+        // before, and verify they are used.
+        when(mock, add)
+            .with(1, 1)
+            .returns(3);
+        when(mock, add)
+            .with(2, 2)
+            .returns(4);
+        REQUIRE(mock.get().add(1, 1) == 3);
+        REQUIRE(mock.get().add(2, 2) == 4);
+        REQUIRE_THROWS_AS(
+            mock.get().add(3, 3),
+            IMock::Exception::UnmockedCallException);
+    }
+
+    SECTION("call counts created before a reset are kept") {
+        // Create a mock, add a mock case and call it.
+        IMock::Mock<ICalculator> mock;
+        IMock::CallCount callCount = when(mock, add)
+            .with(1, 1)
+            .returns(2);
+        mock.get().add(1, 1);
+
+        // Reset the mock, add a new mock case and call it.
+        mock.reset();
+        IMock::CallCount newCallCount = when(mock, add)
+            .with(1, 1)
+            .returns(2);
+        mock.get().add(1, 1);
+        mock.get().add(1, 1);
+
+        // Verify the call counts are independent.
+        REQUIRE_NOTHROW(callCount.verifyCalledOnce());
+        REQUIRE_NOTHROW(newCallCount.verifyCallCount(2));
+    }
+
+    SECTION("adding mock cases after a reset does not allocate memory") {
+        // Create a mock and declare a lambda adding mock cases to it.
+        IMock::Mock<ICalculator> mock;
+        auto addMockCases = [&]() {
+            for(int i = 0; i < 1000; i++) {
+                when(mock, add)
+                    .with(i, i)
+                    .returns(i);
+            }
+            when(mock, subtract).fake(subtractFunction);
+        };
+
+        // Add the mock cases once to let the mock allocate memory for them.
+        addMockCases();
+        mock.reset();
+
+        // Add the mock cases again and verify no memory is allocated.
+        std::size_t allocationCountBefore = allocationCount;
+        addMockCases();
+        std::size_t allocationCountAfter = allocationCount;
+        REQUIRE(allocationCountAfter == allocationCountBefore);
+
+        // Verify the mock cases work.
+        REQUIRE(mock.get().add(999, 999) == 999);
+        REQUIRE(mock.get().subtract(5, 3) == 2);
+    }
+
+    SECTION("reset removes the calls recorded in the journal") {
+        // Create a mock with a journal and make a call.
+        IMock::Mock<ICalculator> mock;
+        mock.enableJournal(4);
+        when(mock, add).fake(subtractFunction);
+        mock.get().add(1, 2);
+
+        // Reset the mock and verify the journal is empty.
+        mock.reset();
+        REQUIRE(mock.getJournal().empty());
+
+        // Verify calls are still recorded, numbered from zero.
+        when(mock, add).fake(subtractFunction);
+        mock.get().add(3, 4);
+        std::vector<IMock::JournalEntry> journal = mock.getJournal();
+        REQUIRE(journal.size() == 1);
+        REQUIRE(journal[0].sequenceNumber == 0);
+        REQUIRE(journal[0].callString == "mock.get().add(3, 4)");
+    }
+
+    SECTION("a pool hands out reset mocks") {
+        // Create a pool.
+        IMock::MockPool<ICalculator> pool;
+        ICalculator* instance;
+
+        {
+            // Acquire a mock and add a mock case to it.
+            IMock::PooledMock<ICalculator> mock = pool.acquire();
+            when(mock, add)
+                .with(1, 1)
+                .returns(2);
+            REQUIRE(mock.get().add(1, 1) == 2);
+            instance = &mock.get();
+            REQUIRE(pool.getIdleCount() == 0);
+        }
+
+        // Verify the mock has been returned.
+        REQUIRE(pool.getIdleCount() == 1);
+
+        {
+            // Acquire a mock and verify it is the same one without any mock
+            // cases.
+            IMock::PooledMock<ICalculator> mock = pool.acquire();
+            REQUIRE(&mock.get() == instance);
+            REQUIRE_THROWS_AS(
+                mock.get().add(1, 1),
+                IMock::Exception::UnknownCallException);
+
+            // Acquire a second mock, which must be a new one.
+            IMock::PooledMock<ICalculator> secondMock = pool.acquire();
+            REQUIRE(&secondMock.get() != instance);
+        }
+
+        // Verify both mocks have been returned.
+        REQUIRE(pool.getIdleCount() == 2);
+    }
+}
+
+TEST_CASE("creating a Mock allocates memory once", "[construction]") {
+    // Create a Mock of ICalculator to let the layout of the interface be
+    // calculated.
+    {
+        IMock::Mock<ICalculator> mock;
+    }
+
+    // Get the number of allocations before the Mock is created.
+    std::size_t allocationCountBefore = allocationCount;
+
+    // Create another Mock of ICalculator.
+    IMock::Mock<ICalculator> mock;
+
+    // Verify only the virtual table was allocated.
+    REQUIRE(allocationCount - allocationCountBefore == 1);
+
+    // Verify the Mock works.
+    when(mock, add)
+        .with(1, 2)
+        .returns(3);
+    REQUIRE(mock.get().add(1, 2) == 3);
+}
+
+/// A MemoryResource keeping track of the blocks it has allocated.
+class CountingMemoryResource : public IMock::MemoryResource {
+    private:
+        /// The number of blocks currently allocated.
+        int _blockCount;
+
+    public:
+        /// Creates a CountingMemoryResource without any allocated blocks.
+        CountingMemoryResource()
+            : _blockCount(0) {
+        }
+
+        /// Allocates a block and counts it.
+        void* allocate(std::size_t size, std::size_t) override {
+            _blockCount++;
+            return ::operator new(size);
+        }
+
+        /// Deallocates a block and stops counting it.
+        void deallocate(void* memory, std::size_t, std::size_t)
+            noexcept override {
+            _blockCount--;
+            ::operator delete(memory);
+        }
+
+        /// Gets the number of blocks currently allocated.
+        int getBlockCount() const {
+            return _blockCount;
+        }
+};
+
+TEST_CASE("can store mock cases in memory from a MemoryResource",
+    "[memory_resource]") {
+    // The number of mock cases to add.
+    const int mockCaseCount = 10000;
+
+    // Create a CountingMemoryResource that outlives the Mock.
+    CountingMemoryResource memoryResource;
+
+    {
+        // Create a Mock of ICalculator using the MemoryResource.
+        IMock::Mock<ICalculator> mock(memoryResource);
+
+        // Get the number of allocations before the mock cases are added.
+        std::size_t allocationCountBefore = allocationCount;
+
+        // Mock add with a large number of arguments and subtract with a fake.
+        for(int i = 0; i < mockCaseCount; i++) {
+            when(mock, add)
+                .with(i, i)
+                .returns(i);
+        }
+        when(mock, subtract)
+            .fake([](int a, int b) {
+                return a - b;
+            });
+
+        // Verify the mock cases were not allocated one by one using operator
+        // new, but stored in blocks from the MemoryResource.
+        REQUIRE(allocationCount - allocationCountBefore < 100);
+        REQUIRE(memoryResource.getBlockCount() > 0);
+        REQUIRE(memoryResource.getBlockCount() < 100);
+
+        // Verify the mock cases work.
+        REQUIRE(mock.get().add(0, 0) == 0);
+        REQUIRE(mock.get().add(mockCaseCount - 1, mockCaseCount - 1)
+            == mockCaseCount - 1);
+        REQUIRE(mock.get().subtract(5, 3) == 2);
+    }
+
+    // Verify every block was released when the Mock was destroyed.
+    REQUIRE(memoryResource.getBlockCount() == 0);
+}
+
+/// A MemoryResource handing out blocks that end 16 bytes after a multiple of
+/// 64 bytes, which keeps the end of a block from being aligned to 64 bytes,
+/// and remembering where the last block ends.
+class UnalignedEndMemoryResource : public IMock::MemoryResource {
+    private:
+        /// The end of the most recently allocated block.
+        char* _lastBlockEnd;
+
+    public:
+        /// Creates an UnalignedEndMemoryResource.
+        UnalignedEndMemoryResource()
+            : _lastBlockEnd(nullptr) {
+        }
+
+        /// Allocates a block and remembers where it ends.
+        void* allocate(std::size_t size, std::size_t) override {
+            // Allocate room for the block, the offset and a pointer to the
+            // allocated memory.
+            char* allocated = static_cast<char*>(::operator new(size + 128));
+
+            // Place the block 16 bytes after a multiple of 64 bytes, which
+            // makes the first block end there as well since its size is a
+            // multiple of 64 bytes, and store the allocated pointer just
+            // before it.
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(
+                allocated + sizeof(void*));
+            std::uintptr_t alignedAddress = (address + 63)
+                & ~static_cast<std::uintptr_t>(63);
+            char* block = allocated + (alignedAddress - address)
+                + sizeof(void*) + 16;
+            reinterpret_cast<char**>(block)[-1] = allocated;
+
+            // Remember where the block ends and return it.
+            _lastBlockEnd = block + size;
+            return block;
+        }
+
+        /// Deallocates a block.
+        void deallocate(void* memory, std::size_t, std::size_t)
+            noexcept override {
+            // Deallocate the memory stored just before the block.
+            ::operator delete(static_cast<char**>(memory)[-1]);
+        }
+
+        /// Gets the end of the most recently allocated block.
+        char* getLastBlockEnd() const {
+            // Return the end of the most recently allocated block.
+            return _lastBlockEnd;
+        }
+};
+
+TEST_CASE("an Arena keeps over-aligned values within its blocks",
+    "[memory_resource]") {
+    // Create an Arena using an UnalignedEndMemoryResource.
+    UnalignedEndMemoryResource memoryResource;
+    IMock::Internal::Arena arena(memoryResource);
+
+    // Fill the first block until a single byte is left.
+    char* memory = static_cast<char*>(arena.allocate(1, 1));
+    while(memory + 2 != memoryResource.getLastBlockEnd()) {
+        memory = static_cast<char*>(arena.allocate(1, 1));
+    }
+    char* firstBlockEnd = memoryResource.getLastBlockEnd();
+
+    // Allocate memory aligned to 64 bytes, which would end up past the end
+    // of the first block if it was aligned there.
+    char* alignedMemory = static_cast<char*>(arena.allocate(8, 64));
+
+    // Verify the memory is aligned and was placed in a new block.
+    REQUIRE(reinterpret_cast<std::uintptr_t>(alignedMemory) % 64 == 0);
+    REQUIRE(memoryResource.getLastBlockEnd() != firstBlockEnd);
+    REQUIRE(alignedMemory + 8 <= memoryResource.getLastBlockEnd());
+}
+
 // An interface with an identity method.
 class IIdentity {
     public:
         virtual int id(int) = 0;
 };
 
+TEST_CASE("can record calls in a journal", "[journal]") {
+    SECTION("records the most recent calls to every method in order") {
+        // Create a Mock of ICalculator keeping three calls per method.
+        IMock::Mock<ICalculator> mock;
+        when(mock, add)
+            .fake([](int a, int b) {
+                return a + b;
+            });
+        mock.enableJournal(3);
+
+        // Mock subtract after the journal has been enabled.
+        when(mock, subtract)
+            .with(5, 3)
+            .returns(2);
+
+        // Make calls, including one not matching any mock case.
+        mock.get().add(1, 1);
+        mock.get().subtract(5, 3);
+        mock.get().add(2, 2);
+        mock.get().add(3, 3);
+        REQUIRE_THROWS_AS(
+            mock.get().subtract(1, 1),
+            IMock::Exception::UnmockedCallException);
+        mock.get().add(4, 4);
+
+        // Verify the journal contains the most recent calls in order.
+        std::vector<IMock::JournalEntry> journal = mock.getJournal();
+        REQUIRE(journal.size() == 5);
+        REQUIRE(journal[0].sequenceNumber == 1);
+        REQUIRE(journal[0].callString == "mock.get().subtract(5, 3)");
+        REQUIRE(journal[1].sequenceNumber == 2);
+        REQUIRE(journal[1].callString == "mock.get().add(2, 2)");
+        REQUIRE(journal[2].sequenceNumber == 3);
+        REQUIRE(journal[2].callString == "mock.get().add(3, 3)");
+        REQUIRE(journal[3].sequenceNumber == 4);
+        REQUIRE(journal[3].callString == "mock.get().subtract(1, 1)");
+        REQUIRE(journal[4].sequenceNumber == 5);
+        REQUIRE(journal[4].callString == "mock.get().add(4, 4)");
+    }
+
+    SECTION("samples one in a number of calls") {
+        // Create a Mock of IIdentity recording every third call.
+        IMock::Mock<IIdentity> mock;
+        when(mock, id)
+            .fake([](int value) {
+                return value;
+            });
+        mock.enableJournal(100, 3);
+
+        // Make ten calls.
+        for(int i = 0; i < 10; i++) {
+            mock.get().id(i);
+        }
+
+        // Verify every third call was recorded.
+        std::vector<IMock::JournalEntry> journal = mock.getJournal();
+        REQUIRE(journal.size() == 4);
+        for(int i = 0; i < 4; i++) {
+            REQUIRE(journal[i].sequenceNumber == std::uint64_t(i * 3));
+            REQUIRE(journal[i].callString
+                == "mock.get().id(" + std::to_string(i * 3) + ")");
+        }
+    }
+
+    SECTION("shows arguments that can't be copied as question marks") {
+        // Create a Mock of INoCopy with the journal enabled.
+        IMock::Mock<INoCopy> mock;
+        mock.enableJournal(1);
+        when(mock, setInt)
+            .with(NoCopy(1))
+            .returns();
+
+        // Make a call.
+        mock.get().setInt(NoCopy(1));
+
+        // Verify the call was recorded.
+        std::vector<IMock::JournalEntry> journal = mock.getJournal();
+        REQUIRE(journal.size() == 1);
+        REQUIRE(journal[0].callString == "mock.get().setInt(?)");
+    }
+
+    SECTION("records arguments that can be copied but not assigned") {
+        // Declare an argument type that can be copied but not assigned.
+        struct Constant {
+            const int value;
+        };
+        class IConstant {
+            public:
+                virtual void set(Constant) = 0;
+        };
+
+        // Create a Mock of IConstant with a journal smaller than the number
+        // of calls, which makes the journal overwrite recorded arguments.
+        IMock::Mock<IConstant> mock;
+        mock.enableJournal(1);
+        when(mock, set)
+            .fake([](Constant) {
+            });
+
+        // Make two calls.
+        mock.get().set(Constant{1});
+        mock.get().set(Constant{2});
+
+        // Verify the last call was recorded.
+        std::vector<IMock::JournalEntry> journal = mock.getJournal();
+        REQUIRE(journal.size() == 1);
+        REQUIRE(journal[0].sequenceNumber == 1);
+        REQUIRE(journal[0].callString == "mock.get().set(?)");
+    }
+
+    SECTION("records C strings that are freed after the call") {
+        // Create a Mock of IText with the journal enabled.
+        IMock::Mock<IText> mock;
+        mock.enableJournal(2);
+        when(mock, length)
+            .fake([](const char* text) {
+                return static_cast<int>(std::strlen(text));
+            });
+
+        // Make a call with a string on the heap and a call with a null
+        // pointer.
+        char* text = new char[5];
+        std::strcpy(text, "text");
+        mock.get().length(text);
+        when(mock, length)
+            .with(nullptr)
+            .returns(0);
+        mock.get().length(nullptr);
+
+        // Overwrite and free the string before the journal is read.
+        std::strcpy(text, "free");
+        delete[] text;
+
+        // Verify the journal contains the string the call was made with.
+        std::vector<IMock::JournalEntry> journal = mock.getJournal();
+        REQUIRE(journal.size() == 2);
+        REQUIRE(journal[0].callString == "mock.get().length(text)");
+        REQUIRE(journal[1].callString == "mock.get().length()");
+    }
+
+    SECTION("can't be enabled twice") {
+        // Create a Mock of ICalculator and enable the journal.
+        IMock::Mock<ICalculator> mock;
+        mock.enableJournal(1);
+
+        // Verify the journal can't be enabled again.
+        REQUIRE_THROWS_AS(
+            mock.enableJournal(1),
+            IMock::Exception::JournalEnabledTwiceException);
+    }
+
+    SECTION("can't be enabled without room or without sampling calls") {
+        // Create a Mock of ICalculator.
+        IMock::Mock<ICalculator> mock;
+
+        // Verify the journal can't be enabled with a capacity or a sample
+        // interval of zero.
+        REQUIRE_THROWS_AS(
+            mock.enableJournal(0),
+            IMock::Exception::InvalidJournalSettingsException);
+        REQUIRE_THROWS_AS(
+            mock.enableJournal(4, 0),
+            IMock::Exception::InvalidJournalSettingsException);
+
+        // Verify the journal can still be enabled.
+        mock.enableJournal(4);
+        when(mock, add)
+            .with(1, 1)
+            .returns(2);
+        mock.get().add(1, 1);
+        REQUIRE(mock.getJournal().size() == 1);
+    }
+
+    SECTION("records calls from several threads") {
+        // Create a concurrent Mock of IIdentity with the journal enabled.
+        IMock::Mock<IIdentity> mock(IMock::Concurrency::Concurrent);
+        when(mock, id)
+            .fake([](int value) {
+                return value;
+            });
+        mock.enableJournal(64);
+
+        // Call id from several threads.
+        std::vector<std::thread> threads;
+        for(int thread = 0; thread < 4; thread++) {
+            threads.emplace_back([&]() {
+                for(int call = 0; call < 1000; call++) {
+                    mock.get().id(call);
+                }
+            });
+        }
+        for(std::thread& thread : threads) {
+            thread.join();
+        }
+
+        // Verify the journal is bounded and its calls are unique and ordered.
+        std::vector<IMock::JournalEntry> journal = mock.getJournal();
+        REQUIRE(journal.size() <= 64);
+        for(std::size_t i = 1; i < journal.size(); i++) {
+            REQUIRE(journal[i - 1].sequenceNumber
+                < journal[i].sequenceNumber);
+        }
+    }
+}
+
 TEST_CASE("benchmark", "[.][benchmark]") {
     // Declare a utility class.
     class HeavyMock {
@@ -1243,3 +3160,174 @@ TEST_CASE("benchmark", "[.][benchmark]") {
     benchmarkMockCalls(524288)
     benchmarkMockCalls(1048576)
 }
+
+TEST_CASE("table benchmark", "[.][benchmark]") {
+    // Create a table mapping every value to itself.
+    const int entryCount = 1000000;
+    std::vector<std::pair<std::tuple<int>, int>> entries;
+    entries.reserve(entryCount);
+    for(int i = 0; i < entryCount; i++) {
+        entries.emplace_back(std::make_tuple(i), i);
+    }
+
+    // Add the entries one by one, which is what the table is compared with.
+    BENCHMARK("1000000 entries with with() and returns()") {
+        IMock::Mock<IIdentity> mock;
+        for(int i = 0; i < entryCount; i++) {
+            when(mock, id)
+                .with(i)
+                .returns(i);
+        }
+        return mock.get().id(0);
+    };
+
+    // Add the entries as a table.
+    BENCHMARK("1000000 entries with table()") {
+        IMock::Mock<IIdentity> mock;
+        when(mock, id).table(entries);
+        return mock.get().id(0);
+    };
+}
+
+/// An interface with a single method taking a reference.
+class IReferenceIdentity {
+    public:
+        virtual int id(const int&) = 0;
+};
+
+TEST_CASE("unindexed mock case benchmark", "[.][benchmark]") {
+    // Create values to mock calls with, which must outlive the mock cases
+    // since the mock cases refer to them.
+    const int mockCaseCount = 200000;
+    std::vector<int> values(mockCaseCount);
+
+    // Mock id for every value. Mock cases for reference arguments are not
+    // indexed and must be scanned.
+    IMock::Mock<IReferenceIdentity> mock;
+    for(int i = 0; i < mockCaseCount; i++) {
+        values[i] = i;
+        when(mock, id)
+            .with(values[i])
+            .returns(i);
+    }
+
+    // Measure calls matching the oldest mock case, which scans every mock
+    // case.
+    int argument = 0;
+    BENCHMARK("call scanning 200000 mock cases") {
+        return mock.get().id(argument);
+    };
+}
+
+/// An interface with a number of methods.
+class IManyMethods {
+    public:
+        virtual int method0(int) = 0;
+        virtual int method1(int) = 0;
+        virtual int method2(int) = 0;
+        virtual int method3(int) = 0;
+        virtual int method4(int) = 0;
+        virtual int method5(int) = 0;
+        virtual int method6(int) = 0;
+        virtual int method7(int) = 0;
+};
+
+TEST_CASE("dispatch benchmark", "[.][benchmark]") {
+    // Declare a macro mocking a method of IManyMethods with a fake.
+    #define mockManyMethods(mock, method) \
+        when(mock, method).fake([](int value) { \
+            return value; \
+        });
+
+    // Create a Mock of IManyMethods where one method is mocked once.
+    IMock::Mock<IManyMethods> mockOneMethod;
+    mockManyMethods(mockOneMethod, method7)
+
+    // Create a Mock of IManyMethods where every method is mocked, which means
+    // many call sites are used.
+    IMock::Mock<IManyMethods> mockEveryMethod;
+    mockManyMethods(mockEveryMethod, method0)
+    mockManyMethods(mockEveryMethod, method1)
+    mockManyMethods(mockEveryMethod, method2)
+    mockManyMethods(mockEveryMethod, method3)
+    mockManyMethods(mockEveryMethod, method4)
+    mockManyMethods(mockEveryMethod, method5)
+    mockManyMethods(mockEveryMethod, method6)
+    mockManyMethods(mockEveryMethod, method7)
+
+    // Measure calls to the same method on both mocks. The time per call should
+    // not depend on the number of mocked methods.
+    BENCHMARK("one mocked method") {
+        return mockOneMethod.get().method7(1);
+    };
+    BENCHMARK("every method mocked") {
+        return mockEveryMethod.get().method7(1);
+    };
+}
+
+TEST_CASE("argument size benchmark", "[.][benchmark]") {
+    // Create a mock handing the vector it is called with back through a fake.
+    IMock::Mock<IForwarding> mock;
+    std::vector<int> vector;
+    when(mock, takeVector).fake([&](std::vector<int> argument) {
+        vector = std::move(argument);
+        return 1;
+    });
+
+    // Declare a macro for benchmark cases where the vector has the provided
+    // size. Since the vector is moved through the call, the time per call
+    // should not depend on its size.
+    #define benchmarkArgumentSize(size) \
+    BENCHMARK(#size " elements") { \
+        return mock.get().takeVector(std::move(vector)); \
+    };
+
+    // Create benchmark cases for vectors of increasing sizes.
+    vector.assign(1, 0);
+    benchmarkArgumentSize(1)
+    vector.assign(1000, 0);
+    benchmarkArgumentSize(1000)
+    vector.assign(1000000, 0);
+    benchmarkArgumentSize(1000000)
+}
+
+TEST_CASE("concurrent call count benchmark", "[.][benchmark]") {
+    // The number of calls made by every thread.
+    const int callCount = 100000;
+
+    // Create a Mock of IIdentity that can be used by several threads and mock
+    // id with a single mock case that every thread calls.
+    IMock::Mock<IIdentity> mock(IMock::Concurrency::Concurrent);
+    IMock::CallCount idCallCount = when(mock, id)
+        .with(0)
+        .returns(0);
+
+    // Declare a macro for benchmark cases where the provided number of threads
+    // call id at once. Since every thread makes the same number of calls, the
+    // time should stay the same as long as there are enough cores.
+    #define benchmarkConcurrentCalls(threadCount) \
+    BENCHMARK(#threadCount " threads") { \
+        std::vector<std::thread> threads; \
+        for(int thread = 0; thread < threadCount; thread++) { \
+            threads.emplace_back([&]() { \
+                for(int call = 0; call < callCount; call++) { \
+                    mock.get().id(0); \
+                } \
+            }); \
+        } \
+        for(std::thread& thread : threads) { \
+            thread.join(); \
+        } \
+    };
+
+    // Create benchmark cases for thread counts that doubles for each new case.
+    benchmarkConcurrentCalls(1)
+    benchmarkConcurrentCalls(2)
+    benchmarkConcurrentCalls(4)
+    benchmarkConcurrentCalls(8)
+    benchmarkConcurrentCalls(16)
+    benchmarkConcurrentCalls(32)
+
+    // Verify the calls were counted, which reads every shard.
+    REQUIRE(idCallCount.getCallCount() % callCount == 0);
+}
@@ -0,0 +1,264 @@
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+// Enable statistics before IMock is included. Since that changes the layout of
+// the mocks, these tests are built as a separate executable.
+#define IMOCK_STATISTICS
+#include <IMock.hpp>
+
+/// An interface representing a calculator.
+class ICalculator {
+    public:
+        virtual int add(int, int) = 0;
+        virtual int subtract(int, int) = 0;
+        virtual int multiply(int, int) = 0;
+        virtual int divide(int, int) = 0;
+};
+
+TEST_CASE("can collect statistics about calls", "[statistics]") {
+    SECTION("describes no methods before any mock case has been added") {
+        // Create a Mock of ICalculator.
+        IMock::Mock<ICalculator> mock;
+
+        // Verify there are no statistics.
+        REQUIRE(mock.getStatistics().empty());
+    }
+
+    SECTION("counts hits, misses and unmatched calls") {
+        // Create a Mock of ICalculator with two indexed mock cases.
+        IMock::Mock<ICalculator> mock;
+        when(mock, add)
+            .with(1, 1)
+            .returns(2);
+        when(mock, add)
+            .with(2, 2)
+            .returns(4);
+
+        // Make a call, repeat it to hit the last matching mock case, make
+        // another call and make a call not matching any mock case.
+        mock.get().add(1, 1);
+        mock.get().add(1, 1);
+        mock.get().add(2, 2);
+        REQUIRE_THROWS_AS(
+            mock.get().add(3, 3),
+            IMock::Exception::UnmockedCallException);
+
+        // Verify the statistics.
+        std::vector<IMock::MethodStatistics> statistics
+            = mock.getStatistics();
+        REQUIRE(statistics.size() == 1);
+        REQUIRE(statistics[0].methodString == "mock.get().add");
+        REQUIRE(statistics[0].callCount == 4);
+        REQUIRE(statistics[0].hitCount == 1);
+        REQUIRE(statistics[0].missCount == 3);
+        REQUIRE(statistics[0].unmatchedCallCount == 1);
+        REQUIRE(statistics[0].scannedMockCaseHistogram
+            == std::vector<std::uint64_t>{3});
+    }
+
+    SECTION("counts a mock case matching every call as a hit") {
+        // Create a Mock of ICalculator with a mock case matching every call.
+        IMock::Mock<ICalculator> mock;
+        when(mock, subtract)
+            .fake([](int a, int b) {
+                return a - b;
+            });
+
+        // Make calls with different arguments.
+        for(int i = 0; i < 5; i++) {
+            mock.get().subtract(i, 1);
+        }
+
+        // Verify every call is a hit.
+        std::vector<IMock::MethodStatistics> statistics
+            = mock.getStatistics();
+        REQUIRE(statistics.size() == 1);
+        REQUIRE(statistics[0].methodString == "mock.get().subtract");
+        REQUIRE(statistics[0].callCount == 5);
+        REQUIRE(statistics[0].hitCount == 5);
+        REQUIRE(statistics[0].missCount == 0);
+        REQUIRE(statistics[0].scannedMockCaseHistogram
+            == std::vector<std::uint64_t>{5});
+    }
+
+    SECTION("records the number of scanned mock cases in a histogram") {
+        // Create a Mock of ICalculator with four mock cases using matchers,
+        // which are scanned from the most recently added one.
+        IMock::Mock<ICalculator> mock;
+        for(int i = 0; i < 4; i++) {
+            when(mock, multiply)
+                .with(IMock::equalTo(i), IMock::any<int>())
+                .returns(i);
+        }
+
+        // Make a call matching the oldest mock case, which checks every mock
+        // case, and a call matching the newest mock case.
+        mock.get().multiply(0, 0);
+        mock.get().multiply(3, 0);
+
+        // Verify one call checked four mock cases and one call checked a
+        // single mock case.
+        std::vector<IMock::MethodStatistics> statistics
+            = mock.getStatistics();
+        REQUIRE(statistics.size() == 1);
+        REQUIRE(statistics[0].missCount == 2);
+        REQUIRE(statistics[0].scannedMockCaseHistogram
+            == std::vector<std::uint64_t>{1, 0, 1});
+    }
+
+    SECTION("describes every method with mock cases") {
+        // Create a Mock of ICalculator mocking two methods.
+        IMock::Mock<ICalculator> mock;
+        when(mock, add)
+            .with(1, 1)
+            .returns(2);
+        when(mock, divide)
+            .with(4, 2)
+            .returns(2);
+
+        // Verify both methods are described without any calls.
+        std::vector<IMock::MethodStatistics> statistics
+            = mock.getStatistics();
+        REQUIRE(statistics.size() == 2);
+        REQUIRE(statistics[0].methodString == "mock.get().add");
+        REQUIRE(statistics[0].callCount == 0);
+        REQUIRE(statistics[0].scannedMockCaseHistogram.empty());
+        REQUIRE(statistics[1].methodString == "mock.get().divide");
+        REQUIRE(statistics[1].callCount == 0);
+    }
+
+    SECTION("counts unknown calls after a reset") {
+        // Create a Mock of ICalculator and make a call.
+        IMock::Mock<ICalculator> mock;
+        when(mock, add)
+            .with(1, 1)
+            .returns(2);
+        mock.get().add(1, 1);
+
+        // Reset the mock and make a call.
+        mock.reset();
+        REQUIRE_THROWS_AS(
+            mock.get().add(1, 1),
+            IMock::Exception::UnknownCallException);
+
+        // Verify only the call made after the reset is counted.
+        std::vector<IMock::MethodStatistics> statistics
+            = mock.getStatistics();
+        REQUIRE(statistics.size() == 1);
+        REQUIRE(statistics[0].callCount == 1);
+        REQUIRE(statistics[0].hitCount == 0);
+        REQUIRE(statistics[0].missCount == 1);
+        REQUIRE(statistics[0].unmatchedCallCount == 1);
+        REQUIRE(statistics[0].scannedMockCaseHistogram.empty());
+    }
+
+    SECTION("records the time taken by calls to fakes") {
+        // Create a Mock of ICalculator with a fake that takes at least two
+        // milliseconds for some arguments and throws for others, and a mock
+        // case returning a value.
+        IMock::Mock<ICalculator> mock;
+        when(mock, divide)
+            .fake([](int a, int b) {
+                if(b == 0) {
+                    throw std::invalid_argument("Division by zero");
+                }
+                if(a < 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                }
+                return a / b;
+            });
+        when(mock, divide)
+            .with(1, 1)
+            .returns(1);
+
+        // Make fast calls, slow calls, a throwing call and a call not
+        // reaching the fake.
+        mock.get().divide(4, 2);
+        mock.get().divide(6, 2);
+        mock.get().divide(-4, 2);
+        mock.get().divide(-6, 2);
+        REQUIRE_THROWS_AS(
+            mock.get().divide(1, 0),
+            std::invalid_argument);
+        mock.get().divide(1, 1);
+
+        // Verify every call to the fake is recorded, with the slow calls in
+        // the buckets of at least 2 to the power of 20 nanoseconds.
+        std::vector<IMock::MethodStatistics> statistics
+            = mock.getStatistics();
+        REQUIRE(statistics.size() == 1);
+        const std::vector<std::uint64_t>& histogram
+            = statistics[0].fakeLatencyHistogram;
+        REQUIRE(statistics[0].callCount == 6);
+        REQUIRE(std::accumulate(
+            histogram.begin(),
+            histogram.end(),
+            std::uint64_t(0)) == 5);
+        REQUIRE(histogram.size() > 20);
+        REQUIRE(std::accumulate(
+            histogram.begin() + 20,
+            histogram.end(),
+            std::uint64_t(0)) == 2);
+    }
+
+    SECTION("records the time taken by fakes matching specific arguments") {
+        // Create a Mock of ICalculator with a fake for specific arguments.
+        IMock::Mock<ICalculator> mock;
+        when(mock, add)
+            .with(1, 1)
+            .fake([](int a, int b) {
+                return a + b;
+            });
+
+        // Make calls to the fake.
+        mock.get().add(1, 1);
+        mock.get().add(1, 1);
+
+        // Verify the calls are recorded and removed by a reset.
+        std::vector<std::uint64_t> histogram
+            = mock.getStatistics()[0].fakeLatencyHistogram;
+        REQUIRE(std::accumulate(
+            histogram.begin(),
+            histogram.end(),
+            std::uint64_t(0)) == 2);
+        mock.reset();
+        REQUIRE(mock.getStatistics()[0].fakeLatencyHistogram.empty());
+    }
+
+    SECTION("counts calls made from several threads at once") {
+        // Create a Mock of ICalculator in concurrent mode.
+        IMock::Mock<ICalculator> mock(IMock::Concurrency::Concurrent);
+        when(mock, add)
+            .fake([](int a, int b) {
+                return a + b;
+            });
+
+        // Make calls from several threads.
+        const int threadCount = 4;
+        const int callsPerThread = 1000;
+        std::vector<std::thread> threads;
+        for(int thread = 0; thread < threadCount; thread++) {
+            threads.emplace_back([&mock]() {
+                for(int call = 0; call < callsPerThread; call++) {
+                    mock.get().add(call, call);
+                }
+            });
+        }
+        for(std::thread& thread : threads) {
+            thread.join();
+        }
+
+        // Verify every call is counted.
+        std::vector<IMock::MethodStatistics> statistics
+            = mock.getStatistics();
+        REQUIRE(statistics.size() == 1);
+        REQUIRE(statistics[0].callCount == threadCount * callsPerThread);
+        REQUIRE(statistics[0].hitCount == threadCount * callsPerThread);
+    }
+}